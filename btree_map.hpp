@@ -0,0 +1,350 @@
+#ifndef BTREE_MAP_HPP_
+# define BTREE_MAP_HPP_
+
+/*
+** btree_map
+** map과 같은 interface를 가지는 B+ tree 기반 map이다.
+** node 하나에 element를 NodeBytes(기본 256 byte)만큼 모아 담으므로, 검색할 때 따라가는 포인터가 적고
+** element마다 node를 할당하지 않아 메모리도 적게 쓴다. 정수 key는 node 안을 처음부터 차례로 비교한다.
+** map과 달리 삽입과 삭제가 element를 node 사이로 옮기므로, 삽입과 삭제 뒤에는 모든 iterator와 참조가 무효화된다.
+*/
+
+# include <functional>  // std::less
+# include <memory>      // std::allocator
+# include <stdexcept>   // std::out_of_range
+# include "utils/algorithm.hpp"
+# include "utils/btree.hpp"
+# include "utils/iterator.hpp"
+# include "utils/utility.hpp"
+
+namespace ft {
+  template < class Key, class T, class Compare = std::less<Key>, class Alloc = std::allocator<ft::pair<const Key, T> >, std::size_t NodeBytes = 256 >
+  class btree_map {
+    public:
+    /* ============================================================ */
+    /*                                                              */
+    /*                         Member types                         */
+    /*                                                              */
+    /* ============================================================ */
+    typedef Key                                                           key_type;
+    typedef T                                                             mapped_type;
+    typedef ft::pair<const key_type, mapped_type>                         value_type;
+    typedef Compare                                                       key_compare;
+    typedef Alloc                                                         allocator_type;
+    typedef typename allocator_type::template rebind<value_type>::other   type_allocator;
+    typedef typename type_allocator::pointer                              pointer;
+    typedef typename type_allocator::const_pointer                        const_pointer;
+    typedef value_type&                                                   reference;
+    typedef const value_type&                                             const_reference;
+    typedef std::size_t                                                   size_type;
+    typedef std::ptrdiff_t                                                difference_type;
+
+    class value_compare {
+      protected:
+      key_compare comp;
+
+      public:
+      typedef bool        result_type;
+      typedef value_type  first_argument_type;
+      typedef value_type  second_argument_type;
+
+      value_compare(key_compare c) : comp(c) {}
+      ~value_compare() {}
+
+      bool operator()(const value_type& x, const value_type& y) const {
+        return (comp(x.first, y.first));
+      }
+    };
+
+    private:
+    typedef ft::btree<value_type, key_type, ft::select_first<value_type>, key_compare, allocator_type, NodeBytes>  tree_type;
+
+    public:
+    typedef typename tree_type::iterator          iterator;
+    typedef typename tree_type::const_iterator    const_iterator;
+    typedef ft::reverse_iterator<iterator>        reverse_iterator;
+    typedef ft::reverse_iterator<const_iterator>  const_reverse_iterator;
+
+    private:
+    key_compare     _key_comp;
+    tree_type       _tree;
+
+    public:
+    /* ============================================================ */
+    /*                                                              */
+    /*                       Member functions                       */
+    /*                                                              */
+    /* ============================================================ */
+
+    /* Constructor (1) empty */
+    explicit btree_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+      : _key_comp(comp), _tree(comp, alloc) {}
+    /* Constructor (2) range */
+    template <class InputIterator>
+    btree_map(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+      : _key_comp(comp), _tree(comp, alloc) {
+        insert(first, last);
+      }
+    /* Constructor (3) copy */
+    btree_map(const btree_map& x)
+      : _key_comp(x._key_comp), _tree(x._tree) {}
+
+    /* Destructor */
+    ~btree_map() {}
+
+    /* Copy container content */
+    btree_map& operator=(const btree_map& x) {
+      if (this != &x) {
+        _key_comp = x._key_comp;
+        _tree = x._tree;
+      }
+      return (*this);
+    }
+
+    /* ============================================================ */
+    /*                          Iterators                           */
+    /* ============================================================ */
+
+    /* Return iterator to beginning */
+    iterator begin() {
+      return (_tree.begin());
+    }
+    const_iterator begin() const {
+      return (_tree.begin());
+    }
+
+    /* Return iterator to end */
+    iterator end() {
+      return (_tree.end());
+    }
+    const_iterator end() const {
+      return (_tree.end());
+    }
+
+    /* Return reverse iterator to reverse beginning */
+    reverse_iterator rbegin() {
+      return (reverse_iterator(end()));
+    }
+    const_reverse_iterator rbegin() const {
+      return (const_reverse_iterator(end()));
+    }
+
+    /* Return reverse iterator to reverse end */
+    reverse_iterator rend() {
+      return (reverse_iterator(begin()));
+    }
+    const_reverse_iterator rend() const {
+      return (const_reverse_iterator(begin()));
+    }
+
+    /* ============================================================ */
+    /*                           Capacity                           */
+    /* ============================================================ */
+
+    /* Test whether container is empty */
+    bool empty() const {
+      return (_tree.empty());
+    }
+
+    /* Return container size */
+    size_type size() const {
+      return (_tree.size());
+    }
+
+    /* Return maximum size */
+    size_type max_size() const {
+      return (_tree.max_size());
+    }
+
+    /* ============================================================ */
+    /*                        Element access                        */
+    /* ============================================================ */
+
+    /*
+    ** Access element
+    ** k가 있으면 mapped value의 참조를, 없으면 기본 생성한 mapped value로 새 element를 삽입하고 그 참조를 반환한다.
+    */
+    mapped_type& operator[] (const key_type& k) {
+      iterator it = _tree.lower_bound(k);
+      if (it == end() || _key_comp(k, it->first))
+        it = _tree.insert(ft::make_pair(k, mapped_type())).first;
+      return (it->second);
+    }
+
+    /*
+    ** Access element
+    ** k를 찾아 mapped value에 대한 참조를 반환한다.
+    ** k가 컨테이너에 존재하지 않으면 out_of_range 예외를 throw 한다.
+    */
+    mapped_type& at(const key_type& k) {
+      iterator it = find(k);
+      if (it == end())
+        throw std::out_of_range("ft::btree_map::at");
+      return (it->second);
+    }
+    const mapped_type& at(const key_type& k) const {
+      const_iterator it = find(k);
+      if (it == end())
+        throw std::out_of_range("ft::btree_map::at");
+      return (it->second);
+    }
+
+    /* ============================================================ */
+    /*                          Modifiers                           */
+    /* ============================================================ */
+
+    /*
+    ** Insert element (1) single element
+    ** pair를 반환하는데 first는 삽입한 element의 iterator이고,
+    ** second는 bool이다(새로 삽입했다면 true, 이미 존재했다면 false).
+    */
+    ft::pair<iterator, bool> insert(const value_type& val) {
+      return (_tree.insert(val));
+    }
+    /*
+    ** Insert element (2) with hint
+    ** 새 element가 position 바로 앞에 올 자리이면 검색하지 않는다. end()를 hint로 주면 정렬된 입력을 끝에 붙일 때 빠르다.
+    */
+    iterator insert(iterator position, const value_type& val) {
+      return (_tree.insert(position, val));
+    }
+    /* Insert element (3) range */
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+      _tree.insert(first, last);
+    }
+
+    /* Erase element (1) single element */
+    void erase(iterator position) {
+      _tree.erase(position);
+    }
+    /*
+    ** Erase element (2)
+    ** key 값에 해당하는 element를 지우고 지운 element의 수를 반환한다.
+    */
+    size_type erase(const key_type& k) {
+      return (_tree.erase(k));
+    }
+    /* Erase element (3) range of elements */
+    void erase(iterator first, iterator last) {
+      _tree.erase(first, last);
+    }
+    /*
+    ** Erase element, key range
+    ** key가 [lower, upper) 범위에 있는 element를 모두 지우고 지운 element의 수를 반환한다.
+    ** upper가 lower보다 크지 않으면 아무것도 지우지 않는다.
+    */
+    size_type erase(const key_type& lower, const key_type& upper) {
+      if (!_key_comp(lower, upper))
+        return (0);
+      return (_tree.erase(lower_bound(lower), lower_bound(upper)));
+    }
+
+    /* Swap content */
+    void swap(btree_map& x) {
+      std::swap(_key_comp, x._key_comp);
+      _tree.swap(x._tree);
+    }
+
+    /* Clear content */
+    void clear() {
+      _tree.clear();
+    }
+
+    /* ============================================================ */
+    /*                          Observers                           */
+    /* ============================================================ */
+
+    /* Return key comparison object */
+    key_compare key_comp() const {
+      return (_key_comp);
+    }
+
+    /* Return value comparison object */
+    value_compare value_comp() const {
+      return (value_compare(_key_comp));
+    }
+
+    /* ============================================================ */
+    /*                          Operations                          */
+    /* ============================================================ */
+
+    /* Get iterator to element */
+    iterator find(const key_type& k) {
+      return (_tree.find(k));
+    }
+    const_iterator find(const key_type& k) const {
+      return (_tree.find(k));
+    }
+
+    /* Count elements with a specific key */
+    size_type count(const key_type& k) const {
+      return (!(find(k) == end()));
+    }
+
+    /* Return iterator to lower bound */
+    iterator lower_bound(const key_type& k) {
+      return (_tree.lower_bound(k));
+    }
+    const_iterator lower_bound(const key_type& k) const {
+      return (_tree.lower_bound(k));
+    }
+
+    /* Return iteartor to upper bound */
+    iterator upper_bound(const key_type& k) {
+      return (_tree.upper_bound(k));
+    }
+    const_iterator upper_bound(const key_type& k) const {
+      return (_tree.upper_bound(k));
+    }
+
+    /* Get range of equal element */
+    ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+      return (_tree.equal_range(k));
+    }
+    ft::pair<iterator, iterator> equal_range(const key_type& k) {
+      return (_tree.equal_range(k));
+    }
+
+    /* ============================================================ */
+    /*                          Allocator                           */
+    /* ============================================================ */
+
+    /* Get allocator */
+    allocator_type get_allocator() const {
+      return (_tree.get_allocator());
+    }
+  };
+
+  template <class Key, class T, class Compare, class Alloc, std::size_t N>
+  bool operator==(const btree_map<Key, T, Compare, Alloc, N>& lhs, const btree_map<Key, T, Compare, Alloc, N>& rhs) {
+    return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+  }
+  template <class Key, class T, class Compare, class Alloc, std::size_t N>
+  bool operator!=(const btree_map<Key, T, Compare, Alloc, N>& lhs, const btree_map<Key, T, Compare, Alloc, N>& rhs) {
+    return (!(lhs == rhs));
+  }
+  template <class Key, class T, class Compare, class Alloc, std::size_t N>
+  bool operator< (const btree_map<Key, T, Compare, Alloc, N>& lhs, const btree_map<Key, T, Compare, Alloc, N>& rhs) {
+    return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+  }
+  template <class Key, class T, class Compare, class Alloc, std::size_t N>
+  bool operator<=(const btree_map<Key, T, Compare, Alloc, N>& lhs, const btree_map<Key, T, Compare, Alloc, N>& rhs) {
+    return (!(rhs < lhs));
+  }
+  template <class Key, class T, class Compare, class Alloc, std::size_t N>
+  bool operator> (const btree_map<Key, T, Compare, Alloc, N>& lhs, const btree_map<Key, T, Compare, Alloc, N>& rhs) {
+    return (rhs < lhs);
+  }
+  template <class Key, class T, class Compare, class Alloc, std::size_t N>
+  bool operator>=(const btree_map<Key, T, Compare, Alloc, N>& lhs, const btree_map<Key, T, Compare, Alloc, N>& rhs) {
+    return (!(lhs < rhs));
+  }
+
+  template <class Key, class T, class Compare, class Alloc, std::size_t N>
+  void swap(btree_map<Key, T, Compare, Alloc, N>& lhs, btree_map<Key, T, Compare, Alloc, N>& rhs) {
+    lhs.swap(rhs);
+  }
+}
+
+#endif
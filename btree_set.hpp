@@ -0,0 +1,285 @@
+#ifndef BTREE_SET_HPP_
+# define BTREE_SET_HPP_
+
+/*
+** btree_set
+** key만 담는 btree_map이다. element가 곧 key이므로 leaf에 key가 연속해서 놓이고,
+** 4 byte, 8 byte 정수 key를 std::less로 비교하면 leaf와 internal node 모두 SIMD로 검색한다.
+** 삽입과 삭제 뒤에는 모든 iterator와 참조가 무효화된다.
+*/
+
+# include <functional>  // std::less
+# include <memory>      // std::allocator
+# include "utils/algorithm.hpp"
+# include "utils/btree.hpp"
+# include "utils/iterator.hpp"
+# include "utils/utility.hpp"
+
+namespace ft {
+  template < class T, class Compare = std::less<T>, class Alloc = std::allocator<T>, std::size_t NodeBytes = 256 >
+  class btree_set {
+    public:
+    /* ============================================================ */
+    /*                                                              */
+    /*                         Member types                         */
+    /*                                                              */
+    /* ============================================================ */
+    typedef T                                                             key_type;
+    typedef T                                                             value_type;
+    typedef Compare                                                       key_compare;
+    typedef Compare                                                       value_compare;
+    typedef Alloc                                                         allocator_type;
+    typedef typename allocator_type::template rebind<value_type>::other   type_allocator;
+    typedef typename type_allocator::pointer                              pointer;
+    typedef typename type_allocator::const_pointer                        const_pointer;
+    typedef value_type&                                                   reference;
+    typedef const value_type&                                             const_reference;
+    typedef std::size_t                                                   size_type;
+    typedef std::ptrdiff_t                                                difference_type;
+
+    private:
+    typedef ft::btree<value_type, key_type, ft::identity<value_type>, key_compare, allocator_type, NodeBytes>  tree_type;
+
+    public:
+    /* element를 바꾸면 순서가 깨지므로 iterator도 element를 읽기만 한다. */
+    typedef typename tree_type::const_iterator    iterator;
+    typedef typename tree_type::const_iterator    const_iterator;
+    typedef ft::reverse_iterator<iterator>        reverse_iterator;
+    typedef ft::reverse_iterator<const_iterator>  const_reverse_iterator;
+
+    private:
+    key_compare     _key_comp;
+    tree_type       _tree;
+
+    public:
+    /* ============================================================ */
+    /*                                                              */
+    /*                       Member functions                       */
+    /*                                                              */
+    /* ============================================================ */
+
+    /* Constructor (1) empty */
+    explicit btree_set(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+      : _key_comp(comp), _tree(comp, alloc) {}
+    /* Constructor (2) range */
+    template <class InputIterator>
+    btree_set(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+      : _key_comp(comp), _tree(comp, alloc) {
+        insert(first, last);
+      }
+    /* Constructor (3) copy */
+    btree_set(const btree_set& x)
+      : _key_comp(x._key_comp), _tree(x._tree) {}
+
+    /* Destructor */
+    ~btree_set() {}
+
+    /* Copy container content */
+    btree_set& operator=(const btree_set& x) {
+      if (this != &x) {
+        _key_comp = x._key_comp;
+        _tree = x._tree;
+      }
+      return (*this);
+    }
+
+    /* ============================================================ */
+    /*                          Iterators                           */
+    /* ============================================================ */
+
+    /* Return iterator to beginning */
+    iterator begin() const {
+      return (_tree.begin());
+    }
+
+    /* Return iterator to end */
+    iterator end() const {
+      return (_tree.end());
+    }
+
+    /* Return reverse iterator to reverse beginning */
+    reverse_iterator rbegin() const {
+      return (reverse_iterator(end()));
+    }
+
+    /* Return reverse iterator to reverse end */
+    reverse_iterator rend() const {
+      return (reverse_iterator(begin()));
+    }
+
+    /* ============================================================ */
+    /*                           Capacity                           */
+    /* ============================================================ */
+
+    /* Test whether container is empty */
+    bool empty() const {
+      return (_tree.empty());
+    }
+
+    /* Return container size */
+    size_type size() const {
+      return (_tree.size());
+    }
+
+    /* Return maximum size */
+    size_type max_size() const {
+      return (_tree.max_size());
+    }
+
+    /* ============================================================ */
+    /*                          Modifiers                           */
+    /* ============================================================ */
+
+    /*
+    ** Insert element (1) single element
+    ** pair를 반환하는데 first는 삽입한 element의 iterator이고,
+    ** second는 bool이다(새로 삽입했다면 true, 이미 존재했다면 false).
+    */
+    ft::pair<iterator, bool> insert(const value_type& val) {
+      ft::pair<typename tree_type::iterator, bool> p = _tree.insert(val);
+      return (ft::pair<iterator, bool>(p.first, p.second));
+    }
+    /*
+    ** Insert element (2) with hint
+    ** 새 element가 position 바로 앞에 올 자리이면 검색하지 않는다. end()를 hint로 주면 정렬된 입력을 끝에 붙일 때 빠르다.
+    */
+    iterator insert(iterator position, const value_type& val) {
+      return (_tree.insert(mutable_iterator(position), val));
+    }
+    /* Insert element (3) range */
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+      _tree.insert(first, last);
+    }
+
+    /* Erase element (1) single element */
+    void erase(iterator position) {
+      _tree.erase(mutable_iterator(position));
+    }
+    /*
+    ** Erase element (2)
+    ** val과 같은 element를 지우고 지운 element의 수를 반환한다.
+    */
+    size_type erase(const value_type& val) {
+      return (_tree.erase(val));
+    }
+    /* Erase element (3) range of elements */
+    void erase(iterator first, iterator last) {
+      _tree.erase(mutable_iterator(first), mutable_iterator(last));
+    }
+    /*
+    ** Erase element, key range
+    ** [lower, upper) 범위에 있는 element를 모두 지우고 지운 element의 수를 반환한다.
+    ** upper가 lower보다 크지 않으면 아무것도 지우지 않는다.
+    */
+    size_type erase(const key_type& lower, const key_type& upper) {
+      if (!_key_comp(lower, upper))
+        return (0);
+      return (_tree.erase(_tree.lower_bound(lower), _tree.lower_bound(upper)));
+    }
+
+    /* Swap content */
+    void swap(btree_set& x) {
+      std::swap(_key_comp, x._key_comp);
+      _tree.swap(x._tree);
+    }
+
+    /* Clear content */
+    void clear() {
+      _tree.clear();
+    }
+
+    /* ============================================================ */
+    /*                          Observers                           */
+    /* ============================================================ */
+
+    /* Return key comparison object */
+    key_compare key_comp() const {
+      return (_key_comp);
+    }
+
+    /* Return value comparison object */
+    value_compare value_comp() const {
+      return (_key_comp);
+    }
+
+    /* ============================================================ */
+    /*                          Operations                          */
+    /* ============================================================ */
+
+    /* Get iterator to element */
+    iterator find(const value_type& val) const {
+      return (_tree.find(val));
+    }
+
+    /* Count elements with a specific value */
+    size_type count(const value_type& val) const {
+      return (!(find(val) == end()));
+    }
+
+    /* Return iterator to lower bound */
+    iterator lower_bound(const value_type& val) const {
+      return (_tree.lower_bound(val));
+    }
+
+    /* Return iteartor to upper bound */
+    iterator upper_bound(const value_type& val) const {
+      return (_tree.upper_bound(val));
+    }
+
+    /* Get range of equal elements */
+    ft::pair<iterator, iterator> equal_range(const value_type& val) const {
+      return (_tree.equal_range(val));
+    }
+
+    /* ============================================================ */
+    /*                          Allocator                           */
+    /* ============================================================ */
+
+    /* Get allocator */
+    allocator_type get_allocator() const {
+      return (_tree.get_allocator());
+    }
+
+    /* ============================================================ */
+    /*                   private member function                    */
+    /* ============================================================ */
+
+    private:
+    static typename tree_type::iterator mutable_iterator(iterator it) {
+      return (typename tree_type::iterator(it.leaf(), it.position()));
+    }
+  };
+
+  template <class T, class Compare, class Alloc, std::size_t N>
+  bool operator==(const btree_set<T, Compare, Alloc, N>& lhs, const btree_set<T, Compare, Alloc, N>& rhs) {
+    return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+  }
+  template <class T, class Compare, class Alloc, std::size_t N>
+  bool operator!=(const btree_set<T, Compare, Alloc, N>& lhs, const btree_set<T, Compare, Alloc, N>& rhs) {
+    return (!(lhs == rhs));
+  }
+  template <class T, class Compare, class Alloc, std::size_t N>
+  bool operator< (const btree_set<T, Compare, Alloc, N>& lhs, const btree_set<T, Compare, Alloc, N>& rhs) {
+    return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+  }
+  template <class T, class Compare, class Alloc, std::size_t N>
+  bool operator<=(const btree_set<T, Compare, Alloc, N>& lhs, const btree_set<T, Compare, Alloc, N>& rhs) {
+    return (!(rhs < lhs));
+  }
+  template <class T, class Compare, class Alloc, std::size_t N>
+  bool operator> (const btree_set<T, Compare, Alloc, N>& lhs, const btree_set<T, Compare, Alloc, N>& rhs) {
+    return (rhs < lhs);
+  }
+  template <class T, class Compare, class Alloc, std::size_t N>
+  bool operator>=(const btree_set<T, Compare, Alloc, N>& lhs, const btree_set<T, Compare, Alloc, N>& rhs) {
+    return (!(lhs < rhs));
+  }
+
+  template <class T, class Compare, class Alloc, std::size_t N>
+  void swap(btree_set<T, Compare, Alloc, N>& lhs, btree_set<T, Compare, Alloc, N>& rhs) {
+    lhs.swap(rhs);
+  }
+}
+
+#endif
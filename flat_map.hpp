@@ -0,0 +1,480 @@
+#ifndef FLAT_MAP_HPP_
+# define FLAT_MAP_HPP_
+
+/*
+** flat_map
+** element를 key 순서로 정렬해 Container(기본 ft::vector)에 연속으로 담는 map이다.
+** node가 없어서 메모리를 적게 쓰고, 검색은 이분 탐색, 순회는 배열을 차례로 읽는 것과 같다.
+** 한 번 만들어 두고 여러 번 읽는 map에 알맞다.
+** element 하나를 삽입하거나 지우면 뒤의 element를 옮기므로 O(n)이고, 범위를 삽입하면 정렬해서 O(n + m)에 합친다.
+** 배열에 담으려면 대입할 수 있어야 하므로 value_type은 ft::pair<const Key, T>가 아니라 ft::pair<Key, T>이다.
+** iterator로 key를 바꾸면 순서가 깨지므로 key는 바꾸지 않아야 한다.
+** 삽입과 삭제는 그 위치 뒤의 iterator를, 배열을 다시 할당하면 모든 iterator를 무효화한다.
+*/
+
+# include <functional>  // std::less
+# include <stdexcept>   // std::out_of_range
+# include "vector.hpp"
+# include "utils/algorithm.hpp"
+# include "utils/flat_tree.hpp"
+# include "utils/iterator.hpp"
+# include "utils/utility.hpp"
+
+namespace ft {
+  template < class Key, class T, class Compare = std::less<Key>, class Container = ft::vector<ft::pair<Key, T> > >
+  class flat_map {
+    public:
+    /* ============================================================ */
+    /*                                                              */
+    /*                         Member types                         */
+    /*                                                              */
+    /* ============================================================ */
+    typedef Key                                           key_type;
+    typedef T                                             mapped_type;
+    typedef ft::pair<Key, T>                              value_type;
+    typedef Compare                                       key_compare;
+    typedef Container                                     container_type;
+    typedef typename container_type::allocator_type       allocator_type;
+    typedef typename container_type::pointer              pointer;
+    typedef typename container_type::const_pointer        const_pointer;
+    typedef value_type&                                   reference;
+    typedef const value_type&                             const_reference;
+    typedef typename container_type::size_type            size_type;
+    typedef typename container_type::difference_type      difference_type;
+    typedef typename container_type::iterator             iterator;
+    typedef typename container_type::const_iterator       const_iterator;
+    typedef ft::reverse_iterator<iterator>                reverse_iterator;
+    typedef ft::reverse_iterator<const_iterator>          const_reverse_iterator;
+
+    class value_compare {
+      protected:
+      key_compare comp;
+
+      public:
+      typedef bool        result_type;
+      typedef value_type  first_argument_type;
+      typedef value_type  second_argument_type;
+
+      value_compare(key_compare c) : comp(c) {}
+      ~value_compare() {}
+
+      bool operator()(const value_type& x, const value_type& y) const {
+        return (comp(x.first, y.first));
+      }
+    };
+
+    private:
+    key_compare     _key_comp;
+    container_type  _cont;
+
+    public:
+    /* ============================================================ */
+    /*                                                              */
+    /*                       Member functions                       */
+    /*                                                              */
+    /* ============================================================ */
+
+    /* Constructor (1) empty */
+    explicit flat_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+      : _key_comp(comp), _cont(alloc) {}
+    /*
+    ** Constructor (2) range
+    ** 범위를 한 번에 담은 뒤 정렬하고 중복된 key를 지운다. 같은 key 중에서는 범위에서 먼저 나온 element가 남는다.
+    */
+    template <class InputIterator>
+    flat_map(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+      : _key_comp(comp), _cont(first, last, alloc) {
+        ft::flat_sort_unique(_cont, 0, value_comp());
+      }
+    /*
+    ** Constructor (2) range, sorted unique
+    ** [first, last)가 key 순서로 정렬되어 있고 중복된 key가 없을 때 검사 없이 그대로 담는다.
+    */
+    template <class InputIterator>
+    flat_map(ft::sorted_unique_t, InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+      : _key_comp(comp), _cont(first, last, alloc) {}
+    /*
+    ** Constructor, container
+    ** cont를 복사해서 정렬하고 중복된 key를 지운다.
+    */
+    explicit flat_map(const container_type& cont, const key_compare& comp = key_compare())
+      : _key_comp(comp), _cont(cont) {
+        ft::flat_sort_unique(_cont, 0, value_comp());
+      }
+    /* Constructor (3) copy */
+    flat_map(const flat_map& x)
+      : _key_comp(x._key_comp), _cont(x._cont) {}
+
+    /* Destructor */
+    ~flat_map() {}
+
+    /* Copy container content */
+    flat_map& operator=(const flat_map& x) {
+      if (this != &x) {
+        _key_comp = x._key_comp;
+        _cont = x._cont;
+      }
+      return (*this);
+    }
+
+    /* ============================================================ */
+    /*                          Iterators                           */
+    /* ============================================================ */
+
+    /* Return iterator to beginning */
+    iterator begin() {
+      return (_cont.begin());
+    }
+    const_iterator begin() const {
+      return (_cont.begin());
+    }
+
+    /* Return iterator to end */
+    iterator end() {
+      return (_cont.end());
+    }
+    const_iterator end() const {
+      return (_cont.end());
+    }
+
+    /* Return reverse iterator to reverse beginning */
+    reverse_iterator rbegin() {
+      return (reverse_iterator(end()));
+    }
+    const_reverse_iterator rbegin() const {
+      return (const_reverse_iterator(end()));
+    }
+
+    /* Return reverse iterator to reverse end */
+    reverse_iterator rend() {
+      return (reverse_iterator(begin()));
+    }
+    const_reverse_iterator rend() const {
+      return (const_reverse_iterator(begin()));
+    }
+
+    /* ============================================================ */
+    /*                           Capacity                           */
+    /* ============================================================ */
+
+    /* Test whether container is empty */
+    bool empty() const {
+      return (_cont.empty());
+    }
+
+    /* Return container size */
+    size_type size() const {
+      return (_cont.size());
+    }
+
+    /* Return maximum size */
+    size_type max_size() const {
+      return (_cont.max_size());
+    }
+
+    /* element n개를 다시 할당하지 않고 담을 수 있게 한다. */
+    void reserve(size_type n) {
+      _cont.reserve(n);
+    }
+
+    /* 다 만든 map이 쓰지 않는 공간을 돌려준다. */
+    void shrink_to_fit() {
+      _cont.shrink_to_fit();
+    }
+
+    /* ============================================================ */
+    /*                        Element access                        */
+    /* ============================================================ */
+
+    /*
+    ** Access element
+    ** k가 있으면 mapped value의 참조를, 없으면 기본 생성한 mapped value로 새 element를 삽입하고 그 참조를 반환한다.
+    */
+    mapped_type& operator[] (const key_type& k) {
+      iterator it = lower_bound(k);
+      if (it == end() || _key_comp(k, it->first))
+        it = _cont.insert(it, value_type(k, mapped_type()));
+      return (it->second);
+    }
+
+    /*
+    ** Access element
+    ** k를 찾아 mapped value에 대한 참조를 반환한다.
+    ** k가 컨테이너에 존재하지 않으면 out_of_range 예외를 throw 한다.
+    */
+    mapped_type& at(const key_type& k) {
+      iterator it = find(k);
+      if (it == end())
+        throw std::out_of_range("ft::flat_map::at");
+      return (it->second);
+    }
+    const mapped_type& at(const key_type& k) const {
+      const_iterator it = find(k);
+      if (it == end())
+        throw std::out_of_range("ft::flat_map::at");
+      return (it->second);
+    }
+
+    /* ============================================================ */
+    /*                          Modifiers                           */
+    /* ============================================================ */
+
+    /*
+    ** Insert element (1) single element
+    ** 이분 탐색으로 자리를 찾고 뒤의 element를 한 칸씩 옮긴다.
+    */
+    ft::pair<iterator, bool> insert(const value_type& val) {
+      iterator it = lower_bound(val.first);
+      if (it != end() && !_key_comp(val.first, it->first))
+        return (ft::make_pair(it, false));
+      return (ft::make_pair(_cont.insert(it, val), true));
+    }
+    /*
+    ** Insert element (2) with hint
+    ** val이 position 바로 앞에 올 자리이면 검색하지 않는다.
+    */
+    iterator insert(iterator position, const value_type& val) {
+      if ((position == end() || _key_comp(val.first, position->first))
+          && (position == begin() || _key_comp((position - 1)->first, val.first)))
+        return (_cont.insert(position, val));
+      return (insert(val).first);
+    }
+    /*
+    ** Insert element (3) range
+    ** 범위를 끝에 붙여 정렬하고 중복을 지운 뒤 원래 element와 O(n + m)에 합친다.
+    ** 이미 있는 key는 원래 element를 남긴다.
+    */
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+      size_type mid = _cont.size();
+      _cont.insert(_cont.end(), first, last);
+      try {
+        ft::flat_sort_unique(_cont, mid, value_comp());
+        ft::flat_merge_unique(_cont, mid, value_comp());
+      } catch (...) {
+        _cont.erase(_cont.begin() + mid, _cont.end());
+        throw ;
+      }
+    }
+    /*
+    ** Insert element (3) range, sorted unique
+    ** [first, last)가 정렬되어 있고 중복된 key가 없으면 정렬하지 않고 바로 합친다.
+    */
+    template <class InputIterator>
+    void insert(ft::sorted_unique_t, InputIterator first, InputIterator last) {
+      size_type mid = _cont.size();
+      _cont.insert(_cont.end(), first, last);
+      try {
+        ft::flat_merge_unique(_cont, mid, value_comp());
+      } catch (...) {
+        _cont.erase(_cont.begin() + mid, _cont.end());
+        throw ;
+      }
+    }
+    /*
+    ** Insert element, batch
+    ** map::insert_batch와 같은 이름으로 부를 수 있게 한다. insert(first, last)와 같다.
+    */
+    template <class InputIterator>
+    void insert_batch(InputIterator first, InputIterator last) {
+      insert(first, last);
+    }
+
+    /* Erase element (1) single element */
+    void erase(iterator position) {
+      _cont.erase(position);
+    }
+    /*
+    ** Erase element (2)
+    ** key 값에 해당하는 element를 지우고 지운 element의 수를 반환한다.
+    */
+    size_type erase(const key_type& k) {
+      iterator it = find(k);
+      if (it == end())
+        return (0);
+      _cont.erase(it);
+      return (1);
+    }
+    /* Erase element (3) range of elements */
+    void erase(iterator first, iterator last) {
+      _cont.erase(first, last);
+    }
+    /*
+    ** Erase element, key range
+    ** key가 [lower, upper) 범위에 있는 element를 모두 지우고 지운 element의 수를 반환한다.
+    ** upper가 lower보다 크지 않으면 아무것도 지우지 않는다.
+    */
+    size_type erase(const key_type& lower, const key_type& upper) {
+      if (!_key_comp(lower, upper))
+        return (0);
+      iterator first = lower_bound(lower);
+      iterator last = lower_bound(upper);
+      size_type n = static_cast<size_type>(last - first);
+      _cont.erase(first, last);
+      return (n);
+    }
+
+    /* Swap content */
+    void swap(flat_map& x) {
+      std::swap(_key_comp, x._key_comp);
+      _cont.swap(x._cont);
+    }
+
+    /* Clear content */
+    void clear() {
+      _cont.clear();
+    }
+
+    /* ============================================================ */
+    /*                          Observers                           */
+    /* ============================================================ */
+
+    /* Return key comparison object */
+    key_compare key_comp() const {
+      return (_key_comp);
+    }
+
+    /* Return value comparison object */
+    value_compare value_comp() const {
+      return (value_compare(_key_comp));
+    }
+
+    /* 정렬된 element를 담은 container를 반환한다. */
+    const container_type& container() const {
+      return (_cont);
+    }
+
+    /* ============================================================ */
+    /*                          Operations                          */
+    /* ============================================================ */
+
+    /* Get iterator to element */
+    iterator find(const key_type& k) {
+      iterator it = lower_bound(k);
+      if (it == end() || _key_comp(k, it->first))
+        return (end());
+      return (it);
+    }
+    const_iterator find(const key_type& k) const {
+      const_iterator it = lower_bound(k);
+      if (it == end() || _key_comp(k, it->first))
+        return (end());
+      return (it);
+    }
+
+    /* Count elements with a specific key */
+    size_type count(const key_type& k) const {
+      return (!(find(k) == end()));
+    }
+
+    /* Return iterator to lower bound */
+    iterator lower_bound(const key_type& k) {
+      return (begin() + lower_index(k));
+    }
+    const_iterator lower_bound(const key_type& k) const {
+      return (begin() + lower_index(k));
+    }
+
+    /* Return iteartor to upper bound */
+    iterator upper_bound(const key_type& k) {
+      return (begin() + upper_index(k));
+    }
+    const_iterator upper_bound(const key_type& k) const {
+      return (begin() + upper_index(k));
+    }
+
+    /* Get range of equal element */
+    ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+      const_iterator first = lower_bound(k);
+      const_iterator last = first;
+      if (last != end() && !_key_comp(k, last->first))
+        ++last;
+      return (ft::make_pair(first, last));
+    }
+    ft::pair<iterator, iterator> equal_range(const key_type& k) {
+      iterator first = lower_bound(k);
+      iterator last = first;
+      if (last != end() && !_key_comp(k, last->first))
+        ++last;
+      return (ft::make_pair(first, last));
+    }
+
+    /* ============================================================ */
+    /*                          Allocator                           */
+    /* ============================================================ */
+
+    /* Get allocator */
+    allocator_type get_allocator() const {
+      return (_cont.get_allocator());
+    }
+
+    /* ============================================================ */
+    /*                   private member function                    */
+    /* ============================================================ */
+
+    private:
+    /* key가 k보다 작은 element의 수 */
+    size_type lower_index(const key_type& k) const {
+      size_type lo = 0;
+      size_type n = _cont.size();
+      while (n > 0) {
+        size_type half = n / 2;
+        if (_key_comp(_cont[lo + half].first, k)) {
+          lo += half + 1;
+          n -= half + 1;
+        } else {
+          n = half;
+        }
+      }
+      return (lo);
+    }
+
+    /* key가 k 이하인 element의 수 */
+    size_type upper_index(const key_type& k) const {
+      size_type lo = 0;
+      size_type n = _cont.size();
+      while (n > 0) {
+        size_type half = n / 2;
+        if (!_key_comp(k, _cont[lo + half].first)) {
+          lo += half + 1;
+          n -= half + 1;
+        } else {
+          n = half;
+        }
+      }
+      return (lo);
+    }
+  };
+
+  template <class Key, class T, class Compare, class Container>
+  bool operator==(const flat_map<Key, T, Compare, Container>& lhs, const flat_map<Key, T, Compare, Container>& rhs) {
+    return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+  }
+  template <class Key, class T, class Compare, class Container>
+  bool operator!=(const flat_map<Key, T, Compare, Container>& lhs, const flat_map<Key, T, Compare, Container>& rhs) {
+    return (!(lhs == rhs));
+  }
+  template <class Key, class T, class Compare, class Container>
+  bool operator< (const flat_map<Key, T, Compare, Container>& lhs, const flat_map<Key, T, Compare, Container>& rhs) {
+    return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+  }
+  template <class Key, class T, class Compare, class Container>
+  bool operator<=(const flat_map<Key, T, Compare, Container>& lhs, const flat_map<Key, T, Compare, Container>& rhs) {
+    return (!(rhs < lhs));
+  }
+  template <class Key, class T, class Compare, class Container>
+  bool operator> (const flat_map<Key, T, Compare, Container>& lhs, const flat_map<Key, T, Compare, Container>& rhs) {
+    return (rhs < lhs);
+  }
+  template <class Key, class T, class Compare, class Container>
+  bool operator>=(const flat_map<Key, T, Compare, Container>& lhs, const flat_map<Key, T, Compare, Container>& rhs) {
+    return (!(lhs < rhs));
+  }
+
+  template <class Key, class T, class Compare, class Container>
+  void swap(flat_map<Key, T, Compare, Container>& lhs, flat_map<Key, T, Compare, Container>& rhs) {
+    lhs.swap(rhs);
+  }
+}
+
+#endif
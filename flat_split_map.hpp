@@ -0,0 +1,579 @@
+#ifndef FLAT_SPLIT_MAP_HPP_
+# define FLAT_SPLIT_MAP_HPP_
+
+/*
+** flat_split_map
+** key와 mapped value를 KeyContainer와 MappedContainer에 따로 담는 flat_map이다.
+** 이분 탐색이 key 배열만 읽으므로, mapped value가 클수록 검색이 읽는 메모리가 flat_map보다 적다.
+** 두 container는 element를 메모리에 연속으로 담아야 한다(ft::vector, std::vector 등).
+** iterator는 element를 ft::pair로 담고 있지 않으므로 *it는 key와 mapped value의 참조를 가진 flat_split_reference를 반환한다.
+** it->first, it->second는 flat_map과 같이 쓸 수 있고, value_type으로 변환하면 복사본을 얻는다.
+** 삽입과 삭제는 그 위치 뒤의 iterator를, 배열을 다시 할당하면 모든 iterator를 무효화한다.
+*/
+
+# include <functional>  // std::less
+# include <stdexcept>   // std::out_of_range
+# include "vector.hpp"
+# include "utils/algorithm.hpp"
+# include "utils/flat_tree.hpp"
+# include "utils/iterator.hpp"
+# include "utils/utility.hpp"
+
+namespace ft {
+  template < class Key, class T, class Compare = std::less<Key>,
+    class KeyContainer = ft::vector<Key>, class MappedContainer = ft::vector<T> >
+  class flat_split_map {
+    public:
+    /* ============================================================ */
+    /*                                                              */
+    /*                         Member types                         */
+    /*                                                              */
+    /* ============================================================ */
+    typedef Key                                               key_type;
+    typedef T                                                 mapped_type;
+    typedef ft::pair<Key, T>                                  value_type;
+    typedef Compare                                           key_compare;
+    typedef KeyContainer                                      key_container_type;
+    typedef MappedContainer                                   mapped_container_type;
+    typedef ft::flat_split_iterator<Key, T>                   iterator;
+    typedef ft::flat_split_iterator<Key, const T>             const_iterator;
+    typedef typename iterator::reference                      reference;
+    typedef typename const_iterator::reference                const_reference;
+    typedef typename iterator::pointer                        pointer;
+    typedef typename const_iterator::pointer                  const_pointer;
+    typedef typename key_container_type::size_type            size_type;
+    typedef std::ptrdiff_t                                    difference_type;
+    typedef ft::reverse_iterator<iterator>                    reverse_iterator;
+    typedef ft::reverse_iterator<const_iterator>              const_reverse_iterator;
+
+    class value_compare {
+      protected:
+      key_compare comp;
+
+      public:
+      typedef bool        result_type;
+      typedef value_type  first_argument_type;
+      typedef value_type  second_argument_type;
+
+      value_compare(key_compare c) : comp(c) {}
+      ~value_compare() {}
+
+      bool operator()(const value_type& x, const value_type& y) const {
+        return (comp(x.first, y.first));
+      }
+    };
+
+    private:
+    /* 정렬과 중복 제거는 pair 배열에서 한 뒤 두 배열로 나눠 담는다. */
+    typedef ft::vector<value_type>                            staging_type;
+
+    key_compare             _key_comp;
+    key_container_type      _keys;
+    mapped_container_type   _values;
+
+    public:
+    /* ============================================================ */
+    /*                                                              */
+    /*                       Member functions                       */
+    /*                                                              */
+    /* ============================================================ */
+
+    /* Constructor (1) empty */
+    explicit flat_split_map(const key_compare& comp = key_compare())
+      : _key_comp(comp), _keys(), _values() {}
+    /*
+    ** Constructor (2) range
+    ** 범위를 한 번에 담은 뒤 정렬하고 중복된 key를 지운다. 같은 key 중에서는 범위에서 먼저 나온 element가 남는다.
+    */
+    template <class InputIterator>
+    flat_split_map(InputIterator first, InputIterator last, const key_compare& comp = key_compare())
+      : _key_comp(comp), _keys(), _values() {
+        staging_type staging(first, last);
+        ft::flat_sort_unique(staging, 0, value_comp());
+        assign_sorted(staging);
+      }
+    /*
+    ** Constructor (2) range, sorted unique
+    ** [first, last)가 key 순서로 정렬되어 있고 중복된 key가 없을 때 검사 없이 그대로 담는다.
+    */
+    template <class InputIterator>
+    flat_split_map(ft::sorted_unique_t, InputIterator first, InputIterator last, const key_compare& comp = key_compare())
+      : _key_comp(comp), _keys(), _values() {
+        staging_type staging(first, last);
+        assign_sorted(staging);
+      }
+    /* Constructor (3) copy */
+    flat_split_map(const flat_split_map& x)
+      : _key_comp(x._key_comp), _keys(x._keys), _values(x._values) {}
+
+    /* Destructor */
+    ~flat_split_map() {}
+
+    /* Copy container content */
+    flat_split_map& operator=(const flat_split_map& x) {
+      if (this != &x) {
+        flat_split_map tmp(x);
+        swap(tmp);
+      }
+      return (*this);
+    }
+
+    /* ============================================================ */
+    /*                          Iterators                           */
+    /* ============================================================ */
+
+    /* Return iterator to beginning */
+    iterator begin() {
+      return (iterator(key_data(), value_data()));
+    }
+    const_iterator begin() const {
+      return (const_iterator(key_data(), value_data()));
+    }
+
+    /* Return iterator to end */
+    iterator end() {
+      return (begin() + size());
+    }
+    const_iterator end() const {
+      return (begin() + size());
+    }
+
+    /* Return reverse iterator to reverse beginning */
+    reverse_iterator rbegin() {
+      return (reverse_iterator(end()));
+    }
+    const_reverse_iterator rbegin() const {
+      return (const_reverse_iterator(end()));
+    }
+
+    /* Return reverse iterator to reverse end */
+    reverse_iterator rend() {
+      return (reverse_iterator(begin()));
+    }
+    const_reverse_iterator rend() const {
+      return (const_reverse_iterator(begin()));
+    }
+
+    /* ============================================================ */
+    /*                           Capacity                           */
+    /* ============================================================ */
+
+    /* Test whether container is empty */
+    bool empty() const {
+      return (_keys.empty());
+    }
+
+    /* Return container size */
+    size_type size() const {
+      return (_keys.size());
+    }
+
+    /* Return maximum size */
+    size_type max_size() const {
+      return (_keys.max_size() < _values.max_size() ? _keys.max_size() : _values.max_size());
+    }
+
+    /* element n개를 다시 할당하지 않고 담을 수 있게 한다. */
+    void reserve(size_type n) {
+      _keys.reserve(n);
+      _values.reserve(n);
+    }
+
+    /* 다 만든 map이 쓰지 않는 공간을 돌려준다. */
+    void shrink_to_fit() {
+      _keys.shrink_to_fit();
+      _values.shrink_to_fit();
+    }
+
+    /* ============================================================ */
+    /*                        Element access                        */
+    /* ============================================================ */
+
+    /*
+    ** Access element
+    ** k가 있으면 mapped value의 참조를, 없으면 기본 생성한 mapped value로 새 element를 삽입하고 그 참조를 반환한다.
+    */
+    mapped_type& operator[] (const key_type& k) {
+      size_type idx = lower_index(k);
+      if (idx == size() || _key_comp(k, _keys[idx]))
+        insert_at(idx, k, mapped_type());
+      return (_values[idx]);
+    }
+
+    /*
+    ** Access element
+    ** k를 찾아 mapped value에 대한 참조를 반환한다.
+    ** k가 컨테이너에 존재하지 않으면 out_of_range 예외를 throw 한다.
+    */
+    mapped_type& at(const key_type& k) {
+      size_type idx = find_index(k);
+      if (idx == size())
+        throw std::out_of_range("ft::flat_split_map::at");
+      return (_values[idx]);
+    }
+    const mapped_type& at(const key_type& k) const {
+      size_type idx = find_index(k);
+      if (idx == size())
+        throw std::out_of_range("ft::flat_split_map::at");
+      return (_values[idx]);
+    }
+
+    /* ============================================================ */
+    /*                          Modifiers                           */
+    /* ============================================================ */
+
+    /*
+    ** Insert element (1) single element
+    ** 이분 탐색으로 자리를 찾고 두 배열에서 뒤의 element를 한 칸씩 옮긴다.
+    */
+    ft::pair<iterator, bool> insert(const value_type& val) {
+      size_type idx = lower_index(val.first);
+      if (idx != size() && !_key_comp(val.first, _keys[idx]))
+        return (ft::make_pair(begin() + idx, false));
+      insert_at(idx, val.first, val.second);
+      return (ft::make_pair(begin() + idx, true));
+    }
+    /*
+    ** Insert element (2) with hint
+    ** val이 position 바로 앞에 올 자리이면 검색하지 않는다.
+    */
+    iterator insert(iterator position, const value_type& val) {
+      size_type idx = static_cast<size_type>(position - begin());
+      if ((idx == size() || _key_comp(val.first, _keys[idx])) && (idx == 0 || _key_comp(_keys[idx - 1], val.first))) {
+        insert_at(idx, val.first, val.second);
+        return (begin() + idx);
+      }
+      return (insert(val).first);
+    }
+    /*
+    ** Insert element (3) range
+    ** 범위를 정렬하고 중복을 지운 뒤 원래 element와 O(n + m)에 합친다.
+    ** 이미 있는 key는 원래 element를 남긴다.
+    */
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+      staging_type staging(first, last);
+      ft::flat_sort_unique(staging, 0, value_comp());
+      merge_sorted(staging);
+    }
+    /*
+    ** Insert element (3) range, sorted unique
+    ** [first, last)가 정렬되어 있고 중복된 key가 없으면 정렬하지 않고 바로 합친다.
+    */
+    template <class InputIterator>
+    void insert(ft::sorted_unique_t, InputIterator first, InputIterator last) {
+      staging_type staging(first, last);
+      merge_sorted(staging);
+    }
+    /*
+    ** Insert element, batch
+    ** map::insert_batch와 같은 이름으로 부를 수 있게 한다. insert(first, last)와 같다.
+    */
+    template <class InputIterator>
+    void insert_batch(InputIterator first, InputIterator last) {
+      insert(first, last);
+    }
+
+    /* Erase element (1) single element */
+    void erase(iterator position) {
+      erase_index(static_cast<size_type>(position - begin()), static_cast<size_type>(position - begin()) + 1);
+    }
+    /*
+    ** Erase element (2)
+    ** key 값에 해당하는 element를 지우고 지운 element의 수를 반환한다.
+    */
+    size_type erase(const key_type& k) {
+      size_type idx = find_index(k);
+      if (idx == size())
+        return (0);
+      erase_index(idx, idx + 1);
+      return (1);
+    }
+    /* Erase element (3) range of elements */
+    void erase(iterator first, iterator last) {
+      erase_index(static_cast<size_type>(first - begin()), static_cast<size_type>(last - begin()));
+    }
+    /*
+    ** Erase element, key range
+    ** key가 [lower, upper) 범위에 있는 element를 모두 지우고 지운 element의 수를 반환한다.
+    ** upper가 lower보다 크지 않으면 아무것도 지우지 않는다.
+    */
+    size_type erase(const key_type& lower, const key_type& upper) {
+      if (!_key_comp(lower, upper))
+        return (0);
+      size_type first = lower_index(lower);
+      size_type last = lower_index(upper);
+      erase_index(first, last);
+      return (last - first);
+    }
+
+    /* Swap content */
+    void swap(flat_split_map& x) {
+      std::swap(_key_comp, x._key_comp);
+      _keys.swap(x._keys);
+      _values.swap(x._values);
+    }
+
+    /* Clear content */
+    void clear() {
+      _keys.clear();
+      _values.clear();
+    }
+
+    /* ============================================================ */
+    /*                          Observers                           */
+    /* ============================================================ */
+
+    /* Return key comparison object */
+    key_compare key_comp() const {
+      return (_key_comp);
+    }
+
+    /* Return value comparison object */
+    value_compare value_comp() const {
+      return (value_compare(_key_comp));
+    }
+
+    /* 정렬된 key 배열을 반환한다. */
+    const key_container_type& keys() const {
+      return (_keys);
+    }
+
+    /* key 배열과 같은 순서로 놓인 mapped value 배열을 반환한다. */
+    const mapped_container_type& values() const {
+      return (_values);
+    }
+
+    /* ============================================================ */
+    /*                          Operations                          */
+    /* ============================================================ */
+
+    /* Get iterator to element */
+    iterator find(const key_type& k) {
+      return (begin() + find_index(k));
+    }
+    const_iterator find(const key_type& k) const {
+      return (begin() + find_index(k));
+    }
+
+    /* Count elements with a specific key */
+    size_type count(const key_type& k) const {
+      return (find_index(k) != size());
+    }
+
+    /* Return iterator to lower bound */
+    iterator lower_bound(const key_type& k) {
+      return (begin() + lower_index(k));
+    }
+    const_iterator lower_bound(const key_type& k) const {
+      return (begin() + lower_index(k));
+    }
+
+    /* Return iteartor to upper bound */
+    iterator upper_bound(const key_type& k) {
+      return (begin() + upper_index(k));
+    }
+    const_iterator upper_bound(const key_type& k) const {
+      return (begin() + upper_index(k));
+    }
+
+    /* Get range of equal element */
+    ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+      size_type idx = lower_index(k);
+      size_type last = (idx != size() && !_key_comp(k, _keys[idx])) ? idx + 1 : idx;
+      return (ft::make_pair(begin() + idx, begin() + last));
+    }
+    ft::pair<iterator, iterator> equal_range(const key_type& k) {
+      size_type idx = lower_index(k);
+      size_type last = (idx != size() && !_key_comp(k, _keys[idx])) ? idx + 1 : idx;
+      return (ft::make_pair(begin() + idx, begin() + last));
+    }
+
+    /* ============================================================ */
+    /*                   private member function                    */
+    /* ============================================================ */
+
+    private:
+    const key_type* key_data() const {
+      return (_keys.empty() ? NULL : &_keys[0]);
+    }
+
+    mapped_type* value_data() {
+      return (_values.empty() ? NULL : &_values[0]);
+    }
+    const mapped_type* value_data() const {
+      return (_values.empty() ? NULL : &_values[0]);
+    }
+
+    /* key가 k보다 작은 element의 수 */
+    size_type lower_index(const key_type& k) const {
+      size_type lo = 0;
+      size_type n = _keys.size();
+      while (n > 0) {
+        size_type half = n / 2;
+        if (_key_comp(_keys[lo + half], k)) {
+          lo += half + 1;
+          n -= half + 1;
+        } else {
+          n = half;
+        }
+      }
+      return (lo);
+    }
+
+    /* key가 k 이하인 element의 수 */
+    size_type upper_index(const key_type& k) const {
+      size_type lo = 0;
+      size_type n = _keys.size();
+      while (n > 0) {
+        size_type half = n / 2;
+        if (!_key_comp(k, _keys[lo + half])) {
+          lo += half + 1;
+          n -= half + 1;
+        } else {
+          n = half;
+        }
+      }
+      return (lo);
+    }
+
+    /* key가 k인 element의 위치. 없으면 size()이다. */
+    size_type find_index(const key_type& k) const {
+      size_type idx = lower_index(k);
+      if (idx == size() || _key_comp(k, _keys[idx]))
+        return (size());
+      return (idx);
+    }
+
+    /* 두 배열의 idx 자리에 넣는다. value를 넣다가 실패하면 먼저 넣은 key를 지운다. */
+    void insert_at(size_type idx, const key_type& k, const mapped_type& v) {
+      _keys.insert(_keys.begin() + idx, k);
+      try {
+        _values.insert(_values.begin() + idx, v);
+      } catch (...) {
+        _keys.erase(_keys.begin() + idx);
+        throw ;
+      }
+    }
+
+    void erase_index(size_type first, size_type last) {
+      _keys.erase(_keys.begin() + first, _keys.begin() + last);
+      _values.erase(_values.begin() + first, _values.begin() + last);
+    }
+
+    /* 정렬된 pair 배열을 두 배열로 나눠 담는다. */
+    void assign_sorted(const staging_type& staging) {
+      key_container_type keys;
+      mapped_container_type values;
+      keys.reserve(staging.size());
+      values.reserve(staging.size());
+      for (typename staging_type::const_iterator it = staging.begin(); it != staging.end(); ++it) {
+        keys.push_back(it->first);
+        values.push_back(it->second);
+      }
+      _keys.swap(keys);
+      _values.swap(values);
+    }
+
+    /*
+    ** 정렬되어 있고 중복이 없는 staging을 원래 element와 O(n + m)에 합친다.
+    ** 새 배열에 합친 뒤 바꾸므로 예외가 발생하면 map은 바뀌지 않는다.
+    ** 모두 뒤에 붙을 자리이면 원래 배열 끝에 바로 붙이고, 예외가 발생하면 붙인 element를 지운다.
+    */
+    void merge_sorted(const staging_type& staging) {
+      size_type n = size();
+      size_type m = staging.size();
+      if (m == 0)
+        return ;
+      if (n == 0 || _key_comp(_keys[n - 1], staging[0].first)) {
+        append_sorted(staging);
+        return ;
+      }
+      key_container_type keys;
+      mapped_container_type values;
+      keys.reserve(n + m);
+      values.reserve(n + m);
+      size_type i = 0;
+      size_type j = 0;
+      while (i < n && j < m) {
+        if (_key_comp(staging[j].first, _keys[i])) {
+          keys.push_back(staging[j].first);
+          values.push_back(staging[j].second);
+          ++j;
+        } else {
+          if (!_key_comp(_keys[i], staging[j].first))
+            ++j;
+          keys.push_back(_keys[i]);
+          values.push_back(_values[i]);
+          ++i;
+        }
+      }
+      for (; i < n; ++i) {
+        keys.push_back(_keys[i]);
+        values.push_back(_values[i]);
+      }
+      for (; j < m; ++j) {
+        keys.push_back(staging[j].first);
+        values.push_back(staging[j].second);
+      }
+      _keys.swap(keys);
+      _values.swap(values);
+    }
+
+    void append_sorted(const staging_type& staging) {
+      size_type n = size();
+      _keys.reserve(n + staging.size());
+      _values.reserve(n + staging.size());
+      try {
+        for (typename staging_type::const_iterator it = staging.begin(); it != staging.end(); ++it) {
+          _keys.push_back(it->first);
+          _values.push_back(it->second);
+        }
+      } catch (...) {
+        _keys.erase(_keys.begin() + n, _keys.end());
+        _values.erase(_values.begin() + n, _values.end());
+        throw ;
+      }
+    }
+  };
+
+  template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  bool operator==(const flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& lhs,
+    const flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& rhs) {
+      return (lhs.size() == rhs.size() && ft::equal(lhs.keys().begin(), lhs.keys().end(), rhs.keys().begin())
+        && ft::equal(lhs.values().begin(), lhs.values().end(), rhs.values().begin()));
+    }
+  template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  bool operator!=(const flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& lhs,
+    const flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& rhs) {
+      return (!(lhs == rhs));
+    }
+  template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  bool operator< (const flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& lhs,
+    const flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& rhs) {
+      return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+    }
+  template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  bool operator<=(const flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& lhs,
+    const flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& rhs) {
+      return (!(rhs < lhs));
+    }
+  template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  bool operator> (const flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& lhs,
+    const flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& rhs) {
+      return (rhs < lhs);
+    }
+  template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  bool operator>=(const flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& lhs,
+    const flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& rhs) {
+      return (!(lhs < rhs));
+    }
+
+  template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  void swap(flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& lhs,
+    flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& rhs) {
+      lhs.swap(rhs);
+    }
+}
+
+#endif
@@ -1,7 +1,158 @@
 #include <iostream>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
 #include "vector.hpp"
 #include "stack.hpp"
 #include "map.hpp"
+#include "incremental_vector.hpp"
+#include "small_vector.hpp"
+#include "flat_map.hpp"
+#include "flat_split_map.hpp"
+#include "btree_map.hpp"
+#include "btree_set.hpp"
+#include "utils/allocator.hpp"
+
+namespace ft {
+  /* threaded map test: key가 long인 map은 이전/다음 node 링크를 가진 layout을 사용한다. */
+  template <>
+  struct tree_node_layout<ft::pair<const long, int> > {
+    typedef threaded_node_layout  type;
+  };
+  /* compact, plain node layout test: key가 short인 map은 색을 bool로 저장하는 layout을 사용한다. */
+  template <>
+  struct tree_node_layout<ft::pair<const short, int> > {
+    typedef plain_node_layout     type;
+  };
+}
+
+/* vector bulk erase test에서 erase_if에 넘기는 조건 */
+static bool is_negative(int x) {
+  return (x < 0);
+}
+static bool is_multiple_of_three(int x) {
+  return (x % 3 == 0);
+}
+static bool is_anything(int) {
+  return (true);
+}
+
+# if __cplusplus >= 201103L
+/* vector move, emplace test에서 element가 복사된 횟수를 센다. 이동은 세지 않는다. */
+struct move_counted {
+  static int  copies;
+  int         value;
+
+  move_counted(int v) : value(v) {}
+  move_counted(const move_counted& x) : value(x.value) {
+    ++copies;
+  }
+  move_counted(move_counted&& x) noexcept : value(x.value) {
+    x.value = -1;
+  }
+  move_counted& operator=(const move_counted& x) {
+    value = x.value;
+    ++copies;
+    return (*this);
+  }
+  move_counted& operator=(move_counted&& x) noexcept {
+    value = x.value;
+    x.value = -1;
+    return (*this);
+  }
+};
+int move_counted::copies = 0;
+# endif
+
+/*
+** simd equal, find, count test
+** 길이가 n인 두 범위를 마지막 element만 다르게 만들어 equal, lexicographical_compare, find, count의 결과를 출력한다.
+*/
+template <class T>
+static void print_simd_case(size_t n) {
+  const T same = static_cast<T>(-2);
+  const T last = static_cast<T>(-1);
+  ft::vector<T> a;
+  for (size_t i = 0; i < n; i++)
+    a.push_back(i % 3 == 0 ? same : static_cast<T>(i));
+  ft::vector<T> b(a);
+  if (n > 0)
+    b.back() = last;
+  std::cout << ft::equal(a.begin(), a.end(), b.begin()) << ft::equal(a.begin(), a.end(), a.begin())
+            << ft::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end())
+            << ft::lexicographical_compare(b.begin(), b.end(), a.begin(), a.end()) << " "
+            << ft::find(b.begin(), b.end(), last) - b.begin() << " " << ft::find(a.begin(), a.end(), last) - a.begin() << " "
+            << ft::count(a.begin(), a.end(), same) << " " << ft::count(b.begin(), b.end(), last) << " / ";
+}
+
+/* trivially relocatable vector test: 힙에 값을 가지고 있어 복사는 비싸지만, 자기 자신을 가리키지 않으므로 memcpy로 옮길 수 있다. */
+struct owned_int {
+  static int  live;
+  int*        value;
+
+  owned_int(int v = 0) : value(new int(v)) {
+    ++live;
+  }
+  owned_int(const owned_int& x) : value(new int(*x.value)) {
+    ++live;
+  }
+  ~owned_int() {
+    delete value;
+    --live;
+  }
+  owned_int& operator=(const owned_int& x) {
+    *value = *x.value;
+    return (*this);
+  }
+};
+int owned_int::live = 0;
+
+namespace ft {
+  template <>
+  struct is_trivially_relocatable<owned_int> : public true_type {};
+}
+
+/* value-less header map test: 기본 생성자가 없는 key와 mapped value */
+struct no_default {
+  int value;
+
+  explicit no_default(int v) : value(v) {}
+  bool operator<(const no_default& x) const {
+    return (value < x.value);
+  }
+};
+
+/* value-less header map test: 할당 횟수를 세는 allocator */
+static int allocation_count = 0;
+
+template <class T>
+struct counted_allocator : public std::allocator<T> {
+  template <class U>
+  struct rebind {
+    typedef counted_allocator<U> other;
+  };
+
+  counted_allocator() {}
+  template <class U>
+  counted_allocator(const counted_allocator<U>&) {}
+
+  T* allocate(size_t n, const void* = NULL) {
+    ++allocation_count;
+    return (std::allocator<T>::allocate(n));
+  }
+};
+
+/* map sorted build, hint insert, clone test: key 비교 횟수를 센다. */
+static int compare_count = 0;
+
+struct counted_less {
+  bool operator()(int x, int y) const {
+    ++compare_count;
+    return (x < y);
+  }
+};
 
 int main(void) {
   std::cout << "============================================================\n"
@@ -124,5 +275,1046 @@ int main(void) {
 
   std::cout << (mp == copy_mp) << " " << (mp != copy_mp) << "\n";
 
+
+  std::cout << "============================================================\n"
+            << "                    map split, join test                    \n"
+            << "============================================================\n";
+
+  ft::map<int, int> left;
+  ft::map<int, int> right;
+  for (int i = 0; i < 100; i++)
+    left[i] = i * 2;
+  right[500] = 1;
+
+  left.split(60, right);
+  std::cout << left.size() << " " << right.size() << "\n";
+  std::cout << left.rbegin()->first << " " << right.begin()->first << " " << right.rbegin()->first << "\n";
+
+  right.erase(right.begin());
+  right[200] = 7;
+  left.join(right);
+  std::cout << left.size() << " " << right.size() << " " << right.empty() << "\n";
+  for (ft::map<int, int>::iterator it = left.lower_bound(55); it != left.end(); it++)
+    std::cout << it->first << ", " << it->second << " ";
+  std::cout << "\n";
+
+  left.split(3, right);
+  right.split(97, left);
+  std::cout << left.size() << " " << right.size() << "\n";
+  right.join(left);
+  std::cout << right.size() << " " << right.begin()->first << " " << right.rbegin()->first << "\n";
+
+  ft::map<int, int>::node_pool_type pool;
+  {
+    ft::map<int, int> shared_left(pool);
+    ft::map<int, int> shared_right(pool);
+    for (int i = 0; i < 40; i++)
+      shared_left[i * 3] = i;
+
+    shared_left.split(31, shared_right);
+    std::cout << shared_left.size() << " " << shared_right.size() << "\n";
+    for (ft::map<int, int>::reverse_iterator rit = shared_right.rbegin(); rit != shared_right.rend(); rit++)
+      std::cout << rit->first << " ";
+    std::cout << "\n";
+
+    shared_right.split(100, right);
+    std::cout << shared_right.size() << " " << right.size() << " " << right.begin()->first << "\n";
+
+    shared_left.join(shared_right);
+    std::cout << shared_left.size() << " " << shared_right.empty() << "\n";
+    right.clear();
+    right.join(shared_left);
+    std::cout << right.size() << " " << shared_left.size() << "\n";
+  }
+
+
+  std::cout << "============================================================\n"
+            << "                 incremental_vector test                    \n"
+            << "============================================================\n";
+
+  ft::incremental_vector<int> inc;
+  inc.set_migration_step(2);
+  for (int i = 0; i < 70; i++) {
+    inc.push_back(i * 3);
+    if (i % 9 == 0)
+      std::cout << inc.size() << ":" << inc[i / 2] << ":" << inc.back() << " ";
+  }
+  std::cout << "\n";
+  for (int i = 0; i < 25; i++)
+    inc.pop_back();
+  for (ft::incremental_vector<int>::iterator it = inc.begin() + 30; it != inc.end(); it++)
+    std::cout << *it << " ";
+  std::cout << "\n";
+  for (int i = 0; i < 40; i++)
+    inc.push_back(inc[i]);
+  for (ft::incremental_vector<int>::reverse_iterator rit = inc.rbegin(); rit != inc.rbegin() + 10; rit++)
+    std::cout << *rit << " ";
+  std::cout << "\n";
+
+  inc.insert(inc.begin() + 5, 3, -1);
+  inc.insert(inc.end(), inc.begin(), inc.begin() + 4);
+  inc.erase(inc.begin() + 10, inc.begin() + 20);
+  inc.erase(inc.end() - 3, inc.end());
+  std::cout << inc.size() << " " << inc.front() << " " << inc.back() << "\n";
+  for (size_t i = 0; i < inc.size(); i += 7)
+    std::cout << inc[i] << " ";
+  std::cout << "\n";
+
+  inc.assign(4, 8);
+  for (ft::incremental_vector<int>::iterator it = inc.begin(); it != inc.end(); it++)
+    std::cout << *it << " ";
+  std::cout << inc.size() << "\n";
+
+
+  std::cout << "============================================================\n"
+            << "                    small_vector test                       \n"
+            << "============================================================\n";
+
+  ft::small_vector<int, 4> small;
+  ft::small_vector<int, 4> other;
+  for (int i = 0; i < 3; i++)
+    small.push_back(i);
+  other.push_back(100);
+
+  small.insert(small.begin() + 1, 3, 7);
+  small.insert(small.end(), small.begin(), small.begin() + 2);
+  for (ft::small_vector<int, 4>::iterator it = small.begin(); it != small.end(); it++)
+    std::cout << *it << " ";
+  std::cout << small.size() << "\n";
+
+  small.swap(other);
+  std::cout << small.size() << " " << small[0] << " " << other.size() << " " << other.back() << "\n";
+  other.erase(other.begin() + 1, other.end() - 1);
+  small.insert(small.begin(), other.begin(), other.end());
+  for (ft::small_vector<int, 4>::reverse_iterator rit = small.rbegin(); rit != small.rend(); rit++)
+    std::cout << *rit << " ";
+  std::cout << small.size() << "\n";
+
+  other.swap(small);
+  small.insert(small.begin(), 5, 42);
+  small.erase(small.begin() + 2, small.begin() + 5);
+  small.swap(other);
+  for (size_t i = 0; i < small.size(); i++)
+    std::cout << small[i] << " ";
+  std::cout << "/ ";
+  for (size_t i = 0; i < other.size(); i++)
+    std::cout << other[i] << " ";
+  std::cout << "\n";
+
+  ft::stack<int, ft::small_vector<int, 4> > small_st;
+  for (int i = 0; i < 6; i++)
+    small_st.push(i * 5);
+  ft::stack<int, ft::small_vector<int, 4> > copy_small_st = small_st;
+  std::cout << small_st.size() << " " << small_st.top() << " " << (small_st == copy_small_st) << "\n";
+  while (small_st.size() > 2)
+    small_st.pop();
+  std::cout << small_st.top() << " " << (small_st < copy_small_st) << "\n";
+
+
+  std::cout << "============================================================\n"
+            << "                flat_map, flat_split_map test               \n"
+            << "============================================================\n";
+
+  ft::pair<int, int> flat_input[] = { ft::make_pair(5, 50), ft::make_pair(1, 10), ft::make_pair(5, 55),
+                                      ft::make_pair(3, 30), ft::make_pair(9, 90), ft::make_pair(1, 11) };
+  ft::pair<int, int> flat_batch[] = { ft::make_pair(4, 40), ft::make_pair(3, 33), ft::make_pair(12, 120),
+                                      ft::make_pair(0, 0), ft::make_pair(12, 121) };
+  ft::pair<int, int> flat_tail[] = { ft::make_pair(20, 200), ft::make_pair(21, 210), ft::make_pair(25, 250) };
+
+  ft::flat_map<int, int> flat(flat_input, flat_input + 6);
+  for (ft::flat_map<int, int>::iterator it = flat.begin(); it != flat.end(); it++)
+    std::cout << it->first << ", " << it->second << " ";
+  std::cout << flat.size() << "\n";
+
+  flat.insert_batch(flat_batch, flat_batch + 5);
+  flat.insert(ft::sorted_unique, flat_tail, flat_tail + 3);
+  ft::flat_map<int, int> flat_sorted(ft::sorted_unique, flat_tail, flat_tail + 3);
+  flat[7] = 70;
+  flat[3] += 1;
+  std::cout << flat[100] << " " << flat.size() << " " << flat_sorted.size() << " " << flat_sorted.begin()->second << "\n";
+  for (ft::flat_map<int, int>::reverse_iterator rit = flat.rbegin(); rit != flat.rend(); rit++)
+    std::cout << rit->first << ", " << rit->second << " ";
+  std::cout << "\n";
+
+  std::cout << flat.erase(3, 21) << " ";
+  std::cout << flat.size() << " " << flat.lower_bound(2)->first << "\n";
+  ft::flat_map<int, int> copy_flat = flat;
+  std::cout << (flat == copy_flat) << " " << (flat_sorted < flat) << "\n";
+
+  ft::flat_split_map<int, int> split_flat(flat_input, flat_input + 6);
+  split_flat.insert_batch(flat_batch, flat_batch + 5);
+  split_flat.insert(ft::sorted_unique, flat_tail, flat_tail + 3);
+  split_flat[8] = 80;
+  split_flat[12] -= 20;
+  for (ft::flat_split_map<int, int>::iterator it = split_flat.begin(); it != split_flat.end(); it++)
+    std::cout << it->first << ", " << it->second << " ";
+  std::cout << split_flat.size() << "\n";
+  for (ft::flat_split_map<int, int>::reverse_iterator rit = split_flat.rbegin(); rit != split_flat.rend(); rit++)
+    std::cout << rit->first << ", " << rit->second << " ";
+  std::cout << "\n";
+
+  std::cout << split_flat.erase(4, 13) << " ";
+  std::cout << split_flat.size() << " " << split_flat.upper_bound(3)->first << "\n";
+  ft::flat_split_map<int, int> copy_split_flat = split_flat;
+  copy_split_flat.erase(copy_split_flat.find(0));
+  std::cout << (split_flat == copy_split_flat) << " " << (split_flat < copy_split_flat) << " " << copy_split_flat.count(1) << "\n";
+
+
+  std::cout << "============================================================\n"
+            << "                 btree_map, btree_set test                  \n"
+            << "============================================================\n";
+
+  ft::btree_map<unsigned int, int> bmap;
+  for (unsigned int i = 0; i < 300; i++)
+    bmap.insert(ft::make_pair((i * 37) % 301, static_cast<int>(i)));
+  for (unsigned int i = 400; i < 420; i++)
+    bmap.insert(bmap.end(), ft::make_pair(i, -1));
+  ft::btree_map<unsigned int, int>::iterator bhint = bmap.insert(bmap.begin(), ft::make_pair(5u, 999));
+  bmap.insert(bhint, ft::make_pair(4000000000u, 4));
+  std::cout << bmap.size() << " " << bhint->second << " " << bmap[5] << " " << bmap.rbegin()->first << "\n";
+  std::cout << bmap.lower_bound(300)->first << " " << bmap.upper_bound(300)->first << " "
+            << bmap.equal_range(410).first->second << " " << bmap.count(301) << "\n";
+
+  bmap.erase(bmap.find(7));
+  std::cout << bmap.erase(8) << " " << bmap.erase(1000) << "\n";
+  bmap.erase(bmap.lower_bound(50), bmap.lower_bound(250));
+  int bcount = 0;
+  for (ft::btree_map<unsigned int, int>::iterator it = bmap.begin(); it != bmap.end(); it++, bcount++)
+    if (bcount % 6 == 0)
+      std::cout << it->first << ", " << it->second << " ";
+  std::cout << bmap.size() << "\n";
+  for (ft::btree_map<unsigned int, int>::reverse_iterator rit = bmap.rbegin(); rit != bmap.rend() && rit->first > 395; rit++)
+    std::cout << rit->first << " ";
+  std::cout << "\n";
+
+  ft::btree_map<unsigned int, int> copy_bmap = bmap;
+  std::cout << (bmap == copy_bmap) << " " << (bmap < copy_bmap) << " ";
+  copy_bmap[260] = 1;
+  std::cout << (bmap == copy_bmap) << " " << (bmap < copy_bmap) << " " << (copy_bmap < bmap) << "\n";
+
+  ft::btree_set<unsigned long> bset;
+  for (unsigned long i = 0; i < 200; i++) {
+    bset.insert(i * 1000003UL);
+    bset.insert(~0UL - i * 7);
+  }
+  std::cout << bset.size() << " " << *bset.lower_bound(~0UL - 700) << " " << *bset.upper_bound(5000000UL) << " "
+            << *bset.rbegin() << " " << bset.count(~0UL - 14) << "\n";
+  bset.erase(bset.lower_bound(1UL << 63), bset.end());
+  bset.erase(bset.begin());
+  std::cout << bset.size() << " " << *bset.begin() << " " << *bset.rbegin() << "\n";
+
+  ft::btree_set<long> signed_set;
+  for (long i = -150; i < 150; i += 3)
+    signed_set.insert(signed_set.end(), i * 100000000000L);
+  std::cout << signed_set.size() << " " << *signed_set.lower_bound(-1) << " " << *signed_set.upper_bound(0) << " ";
+  std::cout << signed_set.erase(-3000000000000L) << " " << signed_set.size() << "\n";
+
+
+  std::cout << "============================================================\n"
+            << "              arena, pool allocator test                    \n"
+            << "============================================================\n";
+
+  ft::monotonic_buffer_resource arena(256);
+  ft::pool_resource pool_res;
+  {
+    ft::vector<int, ft::arena_allocator<int> > arena_vec((ft::arena_allocator<int>(&arena)));
+    ft::vector<int, ft::pool_allocator<int> > pool_vec((ft::pool_allocator<int>(&pool_res)));
+    for (int i = 0; i < 100; i++) {
+      arena_vec.push_back(i * i);
+      pool_vec.push_back(-i);
+    }
+    arena_vec.erase(arena_vec.begin() + 10, arena_vec.begin() + 90);
+    pool_vec.insert(pool_vec.begin() + 50, 5, 7);
+    for (size_t i = 0; i < arena_vec.size(); i++)
+      std::cout << arena_vec[i] << " ";
+    std::cout << arena_vec.size() << "\n";
+    for (size_t i = 47; i < 58; i++)
+      std::cout << pool_vec[i] << " ";
+    std::cout << pool_vec.size() << "\n";
+
+    typedef ft::pair<const int, int> alloc_pair;
+    ft::map<int, int, std::less<int>, ft::arena_allocator<alloc_pair> > arena_map((std::less<int>()), ft::arena_allocator<alloc_pair>(&arena));
+    ft::map<int, int, std::less<int>, ft::pool_allocator<alloc_pair> > pool_map((std::less<int>()), ft::pool_allocator<alloc_pair>(&pool_res));
+    for (int i = 0; i < 200; i++) {
+      arena_map[(i * 7) % 200] = i;
+      pool_map.insert(ft::make_pair(i * 3, i));
+    }
+    for (int i = 0; i < 200; i += 2) {
+      arena_map.erase(i);
+      pool_map.erase(pool_map.find(i * 3));
+    }
+    ft::map<int, int, std::less<int>, ft::pool_allocator<alloc_pair> > copy_pool_map = pool_map;
+    std::cout << arena_map.size() << " " << arena_map.begin()->first << ", " << arena_map.begin()->second << " "
+              << pool_map.size() << " " << pool_map.rbegin()->first << " " << (pool_map == copy_pool_map) << "\n";
+    for (ft::map<int, int, std::less<int>, ft::pool_allocator<alloc_pair> >::iterator it = copy_pool_map.lower_bound(280); it != copy_pool_map.end(); it++)
+      std::cout << it->first << ", " << it->second << " ";
+    std::cout << "\n";
+  }
+  arena.release();
+
+
+  std::cout << "============================================================\n"
+            << "                   mmap allocator test                      \n"
+            << "============================================================\n";
+
+  {
+    ft::vector<int, ft::mmap_allocator<int> > mapped_vec((ft::mmap_allocator<int>(4096)));
+    for (int i = 0; i < 5000; i++)
+      mapped_vec.push_back(i * 2);
+    long mapped_sum = 0;
+    for (ft::vector<int, ft::mmap_allocator<int> >::iterator it = mapped_vec.begin(); it != mapped_vec.end(); it++)
+      mapped_sum += *it;
+    std::cout << mapped_vec.size() << " " << mapped_vec[1234] << " " << mapped_vec.back() << " " << mapped_sum << "\n";
+
+    mapped_vec.erase(mapped_vec.begin() + 100, mapped_vec.end() - 100);
+    mapped_vec.insert(mapped_vec.begin() + 100, 3000, -1);
+    std::cout << mapped_vec.size() << " " << mapped_vec[99] << " " << mapped_vec[100] << " " << mapped_vec[3100] << "\n";
+
+    ft::vector<int, ft::mmap_allocator<int> > populated_vec((ft::mmap_allocator<int>(4096, ft::mmap_allocator<int>::mmap_populate)));
+    populated_vec.assign(3000, 7);
+    populated_vec.insert(populated_vec.end(), mapped_vec.begin(), mapped_vec.begin() + 200);
+    ft::vector<int, ft::mmap_allocator<int> > copy_populated_vec = populated_vec;
+    std::cout << populated_vec.size() << " " << populated_vec[2999] << " " << populated_vec.back() << " "
+              << (populated_vec == copy_populated_vec) << "\n";
+  }
+
+
+  std::cout << "============================================================\n"
+            << "              realloc, mremap growth test                   \n"
+            << "============================================================\n";
+
+  {
+    ft::vector<int, ft::malloc_allocator<int> > malloc_vec;
+    for (int i = 0; i < 100000; i++)
+      malloc_vec.push_back(i % 1000);
+    malloc_vec.reserve(300000);
+    malloc_vec.insert(malloc_vec.begin() + 5, 250000, 3);
+    long malloc_sum = 0;
+    for (size_t i = 0; i < malloc_vec.size(); i++)
+      malloc_sum += malloc_vec[i];
+    std::cout << malloc_vec.size() << " " << malloc_vec[4] << " " << malloc_vec[5] << " " << malloc_vec.back() << " " << malloc_sum << "\n";
+
+    ft::vector<std::string, ft::malloc_allocator<std::string> > malloc_str_vec;
+    for (int i = 0; i < 300; i++)
+      malloc_str_vec.push_back(std::string(i % 40, static_cast<char>('a' + i % 26)));
+    std::cout << malloc_str_vec.size() << " " << malloc_str_vec[27] << " " << malloc_str_vec.back() << "\n";
+
+    ft::vector<long, ft::mmap_allocator<long> > remap_vec((ft::mmap_allocator<long>(64 * 1024)));
+    for (long i = 0; i < 400000; i++)
+      remap_vec.push_back(i * 3);
+    remap_vec.resize(600000, -2);
+    long remap_sum = 0;
+    for (ft::vector<long, ft::mmap_allocator<long> >::iterator it = remap_vec.begin(); it != remap_vec.end(); it++)
+      remap_sum += *it;
+    std::cout << remap_vec.size() << " " << remap_vec[8191] << " " << remap_vec[399999] << " " << remap_vec.back() << " " << remap_sum << "\n";
+  }
+
+
+  std::cout << "============================================================\n"
+            << "                  map insert_batch test                     \n"
+            << "============================================================\n";
+
+  {
+    ft::map<int, int> batch_map;
+    for (int i = 0; i < 50; i++)
+      batch_map[i * 4] = i;
+    ft::vector<ft::pair<int, int> > batch_input;
+    for (int i = 0; i < 300; i++)
+      batch_input.push_back(ft::make_pair((i * 97) % 251, -i));
+    batch_map.insert_batch(batch_input.begin(), batch_input.end());
+    std::cout << batch_map.size() << " " << batch_map[8] << " " << batch_map[9] << " " << batch_map.rbegin()->first << "\n";
+    int batch_count = 0;
+    for (ft::map<int, int>::iterator it = batch_map.begin(); it != batch_map.end(); it++, batch_count++)
+      if (batch_count % 10 == 0)
+        std::cout << it->first << ", " << it->second << " ";
+    std::cout << "\n";
+
+    ft::map<int, int> empty_batch_map;
+    empty_batch_map.insert_batch(batch_input.begin() + 290, batch_input.end());
+    empty_batch_map.insert_batch(batch_input.begin(), batch_input.begin());
+    for (ft::map<int, int>::reverse_iterator rit = empty_batch_map.rbegin(); rit != empty_batch_map.rend(); rit++)
+      std::cout << rit->first << ", " << rit->second << " ";
+    std::cout << empty_batch_map.size() << "\n";
+  }
+
+
+  std::cout << "============================================================\n"
+            << "                 map key range erase test                   \n"
+            << "============================================================\n";
+
+  {
+    ft::map<int, int> range_map;
+    for (int i = 0; i < 500; i++)
+      range_map[i * 2] = i;
+    std::cout << range_map.erase(10, 20) << " ";
+    std::cout << range_map.size() << "\n";
+    std::cout << range_map.erase(101, 701) << " ";
+    std::cout << range_map.size() << " " << range_map.lower_bound(100)->first << " " << range_map.upper_bound(100)->first << "\n";
+    std::cout << range_map.erase(900, 900) << " ";
+    std::cout << range_map.erase(950, 940) << " ";
+    std::cout << range_map.erase(-50, 3) << " ";
+    std::cout << range_map.erase(990, 5000) << " ";
+    std::cout << range_map.size() << "\n";
+    for (ft::map<int, int>::iterator it = range_map.begin(); it != range_map.lower_bound(30); it++)
+      std::cout << it->first << " ";
+    for (ft::map<int, int>::reverse_iterator rit = range_map.rbegin(); rit != range_map.rend() && rit->first > 960; rit++)
+      std::cout << rit->first << " ";
+    std::cout << "\n";
+    std::cout << range_map.erase(-1, 1000) << " ";
+    std::cout << range_map.size() << " " << range_map.empty() << "\n";
+    range_map[7] = 7;
+    std::cout << range_map.size() << " " << range_map.begin()->first << "\n";
+  }
+
+
+  std::cout << "============================================================\n"
+            << "                  vector range insert test                  \n"
+            << "============================================================\n";
+
+  {
+    ft::vector<int> self_vec;
+    for (int i = 0; i < 8; i++)
+      self_vec.push_back(i);
+    self_vec.reserve(64);
+    self_vec.insert(self_vec.begin() + 2, self_vec.begin() + 5, self_vec.end());
+    self_vec.insert(self_vec.begin() + 1, self_vec.begin(), self_vec.begin() + 3);
+    self_vec.insert(self_vec.end(), self_vec.begin() + 10, self_vec.end());
+    for (ft::vector<int>::iterator it = self_vec.begin(); it != self_vec.end(); it++)
+      std::cout << *it << " ";
+    std::cout << self_vec.size() << "\n";
+    self_vec.insert(self_vec.begin(), self_vec.begin(), self_vec.end());
+    const ft::vector<int>& const_self_vec = self_vec;
+    self_vec.insert(self_vec.begin() + 3, const_self_vec.begin() + 30, const_self_vec.end());
+    for (size_t i = 0; i < self_vec.size(); i += 3)
+      std::cout << self_vec[i] << " ";
+    std::cout << self_vec.size() << "\n";
+
+    std::vector<bool> flags;
+    for (int i = 0; i < 7; i++)
+      flags.push_back(i % 3 == 0);
+    ft::vector<bool> bool_vec(4, false);
+    bool_vec.reserve(32);
+    bool_vec.insert(bool_vec.begin() + 2, flags.begin(), flags.end());
+    bool_vec.insert(bool_vec.end(), flags.begin() + 1, flags.begin() + 4);
+    for (size_t i = 0; i < bool_vec.size(); i++)
+      std::cout << bool_vec[i];
+    std::cout << " " << bool_vec.size() << "\n";
+# if __cplusplus >= 201103L
+    std::vector<std::string> words;
+    for (int i = 0; i < 5; i++)
+      words.push_back(std::string(i + 1, static_cast<char>('a' + i)));
+    ft::vector<std::string> moved_words(2, "x");
+    moved_words.insert(moved_words.begin() + 1, std::make_move_iterator(words.begin()), std::make_move_iterator(words.end()));
+    moved_words.insert(moved_words.begin(), std::make_move_iterator(words.begin()), std::make_move_iterator(words.begin()));
+    for (size_t i = 0; i < moved_words.size(); i++)
+      std::cout << moved_words[i] << " ";
+    std::cout << moved_words.size() << "\n";
+# endif
+  }
+
+
+  std::cout << "============================================================\n"
+            << "               small_vector range insert test               \n"
+            << "============================================================\n";
+
+  {
+    ft::small_vector<int, 6> grow_small;
+    for (int i = 0; i < 4; i++)
+      grow_small.push_back(i + 1);
+    grow_small.insert(grow_small.begin() + 1, grow_small.begin() + 2, grow_small.end());
+    std::cout << grow_small.size() << " ";
+    grow_small.insert(grow_small.begin() + 3, grow_small.begin(), grow_small.begin() + 4);
+    std::cout << grow_small.size() << "\n";
+    for (ft::small_vector<int, 6>::iterator it = grow_small.begin(); it != grow_small.end(); it++)
+      std::cout << *it << " ";
+    std::cout << "\n";
+
+    std::vector<bool> small_flags(5, true);
+    small_flags[2] = false;
+    ft::small_vector<bool, 4> small_bools(2, false);
+    small_bools.insert(small_bools.begin() + 1, small_flags.begin(), small_flags.end());
+    for (size_t i = 0; i < small_bools.size(); i++)
+      std::cout << small_bools[i];
+    std::cout << " " << small_bools.size() << "\n";
+# if __cplusplus >= 201103L
+    std::vector<std::string> small_words(3, "word");
+    ft::small_vector<std::string, 2> moved_small(1, "first");
+    moved_small.insert(moved_small.end(), std::make_move_iterator(small_words.begin()), std::make_move_iterator(small_words.end()));
+    for (size_t i = 0; i < moved_small.size(); i++)
+      std::cout << moved_small[i] << " ";
+    std::cout << moved_small.size() << "\n";
+# endif
+  }
+
+
+  std::cout << "============================================================\n"
+            << "                   vector bulk erase test                   \n"
+            << "============================================================\n";
+
+  {
+    ft::vector<int> bulk;
+    for (int i = 0; i < 20; i++)
+      bulk.push_back(i);
+    std::cout << bulk.erase_if(is_negative) << " ";
+    std::cout << bulk.size() << " ";
+    std::cout << bulk.erase_if(is_multiple_of_three) << " ";
+    std::cout << bulk.size() << "\n";
+    for (size_t i = 0; i < bulk.size(); i++)
+      std::cout << bulk[i] << " ";
+    std::cout << "\n";
+
+    size_t dup_indices[] = { 0, 2, 2, 5, 5, 5, 12 };
+    std::cout << bulk.erase_indices(dup_indices, dup_indices + 7) << " ";
+    std::cout << bulk.size() << "\n";
+    size_t unsorted_indices[] = { 7, 1, 3, 1, 0 };
+    std::cout << bulk.erase_indices(unsorted_indices, unsorted_indices + 5) << " ";
+    std::cout << bulk.size() << " ";
+    std::cout << bulk.erase_indices(unsorted_indices, unsorted_indices) << "\n";
+    for (size_t i = 0; i < bulk.size(); i++)
+      std::cout << bulk[i] << " ";
+    std::cout << "\n";
+
+    ft::vector<int>::iterator unordered_it = bulk.erase_unordered(bulk.begin() + 1);
+    std::cout << *unordered_it << " " << bulk.size() << " ";
+    unordered_it = bulk.erase_unordered(bulk.end() - 1);
+    std::cout << (unordered_it == bulk.end()) << " " << bulk.size() << "\n";
+    for (size_t i = 0; i < bulk.size(); i++)
+      std::cout << bulk[i] << " ";
+    std::cout << "\n";
+
+    std::cout << bulk.erase_if(is_anything) << " ";
+    std::cout << bulk.size() << " " << bulk.empty() << "\n";
+    bulk.push_back(42);
+    unordered_it = bulk.erase_unordered(bulk.begin());
+    std::cout << (unordered_it == bulk.end()) << " " << bulk.size() << " " << bulk.empty() << "\n";
+  }
+
+
+  std::cout << "============================================================\n"
+            << "               vector capacity trimming test                \n"
+            << "============================================================\n";
+
+  {
+    ft::vector<int> trim_vec;
+    trim_vec.reserve(64);
+    for (int i = 0; i < 64; i++)
+      trim_vec.push_back(i);
+    trim_vec.resize(10);
+    std::cout << trim_vec.capacity() << " ";
+    trim_vec.pop_back();
+    std::cout << trim_vec.capacity() << " ";
+    trim_vec.erase(trim_vec.begin(), trim_vec.begin() + 2);
+    std::cout << trim_vec.capacity() << " " << trim_vec.size() << "\n";
+
+    trim_vec.set_trim_policy(4);
+    std::cout << trim_vec.capacity() << " ";
+    for (int i = 0; i < 40; i++)
+      trim_vec.push_back(i);
+    std::cout << trim_vec.capacity() << " ";
+    trim_vec.resize(12);
+    std::cout << trim_vec.capacity() << " ";
+    trim_vec.pop_back();
+    std::cout << trim_vec.capacity() << " ";
+    trim_vec.erase(trim_vec.begin() + 1, trim_vec.begin() + 7);
+    std::cout << trim_vec.capacity() << " " << trim_vec.size() << "\n";
+    for (size_t i = 0; i < trim_vec.size(); i++)
+      std::cout << trim_vec[i] << " ";
+    std::cout << "\n";
+
+    trim_vec.shrink_to_fit();
+    std::cout << trim_vec.capacity() << " " << trim_vec.back() << " ";
+    trim_vec.clear();
+    std::cout << trim_vec.capacity() << " ";
+    trim_vec.shrink_to_fit();
+    std::cout << trim_vec.capacity() << " ";
+    ft::vector<int> empty_trim_vec;
+    empty_trim_vec.shrink_to_fit();
+    std::cout << empty_trim_vec.capacity() << " ";
+    empty_trim_vec.reserve(30);
+    empty_trim_vec.shrink_to_fit();
+    std::cout << empty_trim_vec.capacity() << " " << empty_trim_vec.empty() << "\n";
+  }
+
+
+  std::cout << "============================================================\n"
+            << "                 vector move, emplace test                  \n"
+            << "============================================================\n";
+
+# if __cplusplus >= 201103L
+  {
+    ft::vector<std::string> names;
+    names.reserve(4);
+    std::string name = "alpha";
+    names.emplace_back(std::move(name));
+    names.emplace_back(3, 'b');
+    names.emplace(names.begin() + 1, "gamma");
+    names.emplace(names.begin() + 1, 2, 'd');
+    std::cout << name.empty() << " " << names.size() << " " << names.capacity() << "\n";
+    names.emplace(names.begin() + 2, "epsilon");
+    names.emplace(names.begin() + 1, names[3]);
+    names.emplace(names.end(), names.front());
+    for (ft::vector<std::string>::iterator it = names.begin(); it != names.end(); it++)
+      std::cout << *it << " ";
+    std::cout << names.size() << "\n";
+
+    ft::vector<std::string> moved_names(std::move(names));
+    std::cout << names.size() << " " << moved_names.size() << " " << moved_names[1] << " ";
+    ft::vector<std::string> assigned_names(2, "old");
+    assigned_names = std::move(moved_names);
+    std::cout << assigned_names.size() << " " << assigned_names.back() << "\n";
+    std::string moved_back = std::move(assigned_names.back());
+    assigned_names.pop_back();
+    std::cout << moved_back << " " << assigned_names.size() << " " << assigned_names.back() << "\n";
+
+    ft::vector<move_counted> counted;
+    for (int i = 0; i < 5; i++)
+      counted.emplace_back(i);
+    counted.emplace(counted.begin() + 2, 100);
+    counted.insert(counted.begin(), move_counted(7));
+    counted.emplace(counted.begin() + 4, counted[1]);
+    ft::vector<move_counted> moved_counted(std::move(counted));
+    for (size_t i = 0; i < moved_counted.size(); i++)
+      std::cout << moved_counted[i].value << " ";
+    std::cout << counted.size() << " " << move_counted::copies << "\n";
+  }
+# endif
+
+
+  std::cout << "============================================================\n"
+            << "                     threaded map test                      \n"
+            << "============================================================\n";
+
+  {
+    ft::map<long, int> threaded;
+    for (long i = 0; i < 200; i++)
+      threaded[(i * 89) % 200] = static_cast<int>(i);
+    for (long i = 0; i < 200; i += 3)
+      threaded.erase(i);
+    threaded.erase(threaded.find(1));
+    threaded.erase(threaded.lower_bound(150), threaded.lower_bound(170));
+    threaded.insert(threaded.end(), ft::make_pair(300L, -3));
+    std::cout << threaded.size() << " ";
+    long threaded_sum = 0;
+    for (ft::map<long, int>::iterator it = threaded.begin(); it != threaded.end(); it++)
+      threaded_sum += it->first * it->second;
+    std::cout << threaded_sum << " ";
+    threaded_sum = 0;
+    for (ft::map<long, int>::reverse_iterator rit = threaded.rbegin(); rit != threaded.rend(); rit++)
+      threaded_sum += rit->first * rit->second;
+    std::cout << threaded_sum << "\n";
+    ft::map<long, int>::iterator threaded_it = threaded.end();
+    for (int i = 0; i < 6; i++)
+      std::cout << (--threaded_it)->first << " ";
+    for (threaded_it = threaded.lower_bound(145); threaded_it != threaded.upper_bound(175); ++threaded_it)
+      std::cout << threaded_it->first << ", " << threaded_it->second << " ";
+    std::cout << "\n";
+
+    ft::map<long, int> threaded_right;
+    threaded_right[5] = 5;
+    threaded.split(100, threaded_right);
+    std::cout << threaded.size() << " " << threaded_right.size() << " " << threaded.rbegin()->first << " "
+              << (--threaded.end())->first << " " << threaded_right.begin()->first << " " << threaded_right.rbegin()->first << "\n";
+    for (ft::map<long, int>::reverse_iterator rit = threaded_right.rbegin(); rit != threaded_right.rend(); rit++)
+      if (rit->first % 10 == 1)
+        std::cout << rit->first << " ";
+    for (ft::map<long, int>::iterator it = threaded.begin(); it != threaded.end(); it++)
+      if (it->first % 20 == 1)
+        std::cout << it->first << " ";
+    std::cout << "\n";
+
+    threaded_right.erase(threaded_right.begin());
+    threaded_right[1000] = 11;
+    threaded.join(threaded_right);
+    std::cout << threaded.size() << " " << threaded_right.size() << " " << threaded_right.empty() << " ";
+    threaded_sum = 0;
+    for (ft::map<long, int>::reverse_iterator rit = threaded.rbegin(); rit != threaded.rend(); rit++)
+      threaded_sum += rit->first * rit->second;
+    std::cout << threaded_sum << " " << threaded.rbegin()->first << " " << (++threaded.find(98))->first << "\n";
+
+    ft::map<long, int> threaded_copy = threaded;
+    threaded_copy.erase(threaded_copy.begin());
+    threaded_copy.swap(threaded);
+    std::cout << (threaded == threaded_copy) << " " << threaded.begin()->first << " " << threaded_copy.begin()->first << " "
+              << (--threaded.end())->first << "\n";
+    threaded.clear();
+    threaded[3] = 3;
+    std::cout << threaded.size() << " " << threaded.begin()->first << " " << threaded.rbegin()->first << "\n";
+  }
+
+
+  std::cout << "============================================================\n"
+            << "                simd equal, find, count test                \n"
+            << "============================================================\n";
+
+  {
+    const size_t simd_lengths[] = { 0, 1, 15, 16, 17, 33 };
+    for (size_t i = 0; i < 6; i++) {
+      std::cout << simd_lengths[i] << ": ";
+      print_simd_case<signed char>(simd_lengths[i]);
+      print_simd_case<short>(simd_lengths[i]);
+      print_simd_case<int>(simd_lengths[i]);
+      print_simd_case<long>(simd_lengths[i]);
+      std::cout << "\n";
+    }
+  }
+
+
+  std::cout << "============================================================\n"
+            << "             trivially relocatable vector test              \n"
+            << "============================================================\n";
+
+  {
+    ft::vector<owned_int> owned;
+    for (int i = 0; i < 16; i++)
+      owned.push_back(owned_int(i));
+    owned.push_back(owned[3]);
+    std::cout << owned.size() << " " << *owned.back().value << " " << owned_int::live << "\n";
+    owned.reserve(100);
+    owned.insert(owned.begin() + 2, 3, owned_int(-1));
+    owned.erase(owned.begin() + 5, owned.begin() + 8);
+    ft::vector<owned_int> extra_owned(2, owned_int(42));
+    owned.insert(owned.begin(), extra_owned.begin(), extra_owned.end());
+    owned.resize(200, owned_int(9));
+    owned.erase(owned.begin() + 20, owned.end() - 2);
+    for (size_t i = 0; i < owned.size(); i++)
+      std::cout << *owned[i].value << " ";
+    std::cout << owned.size() << " " << owned_int::live << "\n";
+    ft::vector<owned_int> copy_owned(owned);
+    copy_owned.swap(owned);
+    owned.clear();
+    std::cout << owned_int::live << " ";
+  }
+  std::cout << owned_int::live << "\n";
+
+
+  std::cout << "============================================================\n"
+            << "            vector range construct, assign test             \n"
+            << "============================================================\n";
+
+  {
+    std::istringstream numbers("4 8 15 16 23 42");
+    std::istream_iterator<int> number_first(numbers);
+    std::istream_iterator<int> number_last;
+    ft::vector<int> streamed(number_first, number_last);
+    std::list<int> listed;
+    for (int i = 0; i < 9; i++)
+      listed.push_back(i * i);
+    ft::vector<int> from_list(listed.begin(), listed.end());
+    std::cout << streamed.size() << " " << streamed.back() << " " << from_list.size() << " " << from_list.capacity() << "\n";
+
+    std::istringstream more_numbers("7 7 7 1 2");
+    std::istream_iterator<int> more_first(more_numbers);
+    streamed.insert(streamed.begin() + 2, more_first, number_last);
+    from_list.assign(listed.rbegin(), listed.rend());
+    from_list.insert(from_list.end(), listed.begin(), listed.end());
+    for (size_t i = 0; i < streamed.size(); i++)
+      std::cout << streamed[i] << " ";
+    std::cout << streamed.size() << "\n";
+    for (size_t i = 0; i < from_list.size(); i++)
+      std::cout << from_list[i] << " ";
+    std::cout << from_list.size() << "\n";
+
+    std::istringstream few_numbers("3 2 1");
+    std::istream_iterator<int> few_first(few_numbers);
+    from_list.assign(few_first, number_last);
+    std::cout << from_list.size() << " " << from_list.front() << " " << from_list.back() << " ";
+    std::list<int> short_list(2, -5);
+    streamed.assign(short_list.begin(), short_list.end());
+    std::cout << streamed.size() << " " << streamed.back() << " ";
+    ft::map<int, int> range_source;
+    for (int i = 0; i < 6; i++)
+      range_source[i * 10] = -i;
+    ft::vector<ft::pair<const int, int> > from_map(range_source.begin(), range_source.end());
+    std::cout << from_map.size() << " " << from_map[4].first << ", " << from_map[4].second << " ";
+    ft::small_vector<int, 4> small_streamed(listed.begin(), listed.end());
+    std::cout << small_streamed.size() << " " << small_streamed.back() << "\n";
+  }
+
+
+  std::cout << "============================================================\n"
+            << "                  contiguous iterator test                  \n"
+            << "============================================================\n";
+
+  {
+    std::cout << ft::is_contiguous_iterator<ft::vector<int>::iterator>::value
+              << ft::is_contiguous_iterator<ft::vector<int>::const_iterator>::value
+              << ft::is_contiguous_iterator<ft::small_vector<int, 4>::iterator>::value
+              << ft::is_contiguous_iterator<const int*>::value
+              << ft::is_contiguous_iterator<ft::vector<int>::reverse_iterator>::value
+              << ft::is_contiguous_iterator<ft::map<int, int>::iterator>::value
+              << ft::is_contiguous_iterator<std::list<int>::iterator>::value << " "
+              << (sizeof(ft::vector<int>::iterator) == sizeof(int*)) << "\n";
+
+    ft::vector<int> blocks;
+    for (int i = 0; i < 12; i++)
+      blocks.push_back(i);
+    ft::copy(blocks.begin() + 3, blocks.begin() + 9, blocks.begin());
+    ft::copy_backward(blocks.begin(), blocks.begin() + 5, blocks.end());
+    for (ft::vector<int>::const_iterator it = blocks.begin(); it != blocks.end(); it++)
+      std::cout << *it << " ";
+    std::cout << "\n";
+
+    const int raw_blocks[] = { 100, 200, 300, 400 };
+    const ft::vector<int>& const_blocks = blocks;
+    ft::vector<int> contiguous_copy(const_blocks.begin() + 2, const_blocks.end() - 2);
+    contiguous_copy.insert(contiguous_copy.begin() + 1, raw_blocks, raw_blocks + 4);
+    contiguous_copy.insert(contiguous_copy.end(), blocks.begin(), blocks.begin() + 3);
+    ft::small_vector<int, 4> small_blocks(contiguous_copy.begin(), contiguous_copy.begin() + 6);
+    contiguous_copy.assign(small_blocks.begin() + 1, small_blocks.end());
+    for (size_t i = 0; i < contiguous_copy.size(); i++)
+      std::cout << contiguous_copy[i] << " ";
+    std::cout << contiguous_copy.size() << " " << (contiguous_copy < blocks) << "\n";
+  }
+
+
+  std::cout << "============================================================\n"
+            << "             node pool, synchronized pool test              \n"
+            << "============================================================\n";
+
+  {
+    ft::map<int, int>::node_pool_type node_pool(64);
+    ft::map<int, int> pooled_a(node_pool);
+    ft::map<int, int> pooled_b(node_pool);
+    for (int i = 0; i < 100; i++)
+      pooled_a[i] = i;
+    for (int i = 0; i < 50; i++)
+      pooled_b[i * 2] = -i;
+    std::cout << node_pool.in_use() << " ";
+    size_t pool_capacity = node_pool.capacity();
+    pooled_a.clear();
+    std::cout << node_pool.in_use() << " ";
+    for (int i = 0; i < 100; i++)
+      pooled_a.insert(pooled_a.end(), ft::make_pair(i + 1000, i));
+    std::cout << (node_pool.capacity() == pool_capacity) << " ";
+    ft::map<int, int> pooled_copy(pooled_b);
+    pooled_copy.erase(pooled_copy.begin(), pooled_copy.find(60));
+    std::cout << node_pool.in_use() << " "
+              << pooled_a.rbegin()->first << " " << pooled_copy.begin()->first << "\n";
+
+    typedef ft::node_pool<ft::pair<long, long> > pair_pool;
+    pair_pool* lender = new pair_pool();
+    pair_pool borrower;
+    ft::pair<long, long>* lent_nodes[5];
+    for (int i = 0; i < 5; i++)
+      lent_nodes[i] = lender->allocate();
+    borrower.adopt(*lender, 5);
+    std::cout << lender->in_use() << " " << borrower.in_use() << " " << lender->lent() << " ";
+    if (lender->remove_ref())
+      delete lender;
+    for (int i = 0; i < 5; i++)
+      borrower.deallocate(lent_nodes[i]);
+    std::cout << borrower.in_use() << " " << (borrower.allocate() == lent_nodes[4]) << "\n";
+
+    ft::synchronized_pool_resource shared_res;
+    typedef ft::pair<const int, int> sync_pair;
+    ft::map<int, int, std::less<int>, ft::synchronized_pool_allocator<sync_pair> > sync_map((std::less<int>()),
+      ft::synchronized_pool_allocator<sync_pair>(&shared_res));
+    ft::vector<int, ft::synchronized_pool_allocator<int> > sync_vec((ft::synchronized_pool_allocator<int>(&shared_res)));
+    ft::stack<int, ft::vector<int, ft::synchronized_pool_allocator<int> > > sync_st(sync_vec);
+    for (int i = 0; i < 300; i++) {
+      sync_map[(i * 13) % 300] = i;
+      sync_vec.push_back(i);
+      sync_st.push(-i);
+    }
+    for (int i = 0; i < 300; i += 2)
+      sync_map.erase(i);
+    sync_vec.erase(sync_vec.begin() + 10, sync_vec.end() - 10);
+    std::cout << sync_map.size() << " " << sync_map.begin()->second << " " << sync_vec.size() << " " << sync_vec[12] << " "
+              << sync_st.size() << " " << sync_st.top() << "\n";
+  }
+
+
+  std::cout << "============================================================\n"
+            << "                 value-less header map test                 \n"
+            << "============================================================\n";
+
+  {
+    ft::map<no_default, no_default> no_default_map;
+    std::cout << no_default_map.empty() << " " << (no_default_map.begin() == no_default_map.end()) << " "
+              << (no_default_map.find(no_default(1)) == no_default_map.end()) << " ";
+    for (int i = 0; i < 30; i++)
+      no_default_map.insert(ft::make_pair(no_default((i * 7) % 30), no_default(i)));
+    no_default_map.erase(no_default(0));
+    no_default_map.erase(no_default_map.find(no_default(29)));
+    ft::map<no_default, no_default> copy_no_default_map(no_default_map);
+    copy_no_default_map.swap(no_default_map);
+    std::cout << no_default_map.size() << " " << no_default_map.begin()->first.value << " "
+              << (--no_default_map.end())->first.value << " " << no_default_map.lower_bound(no_default(14))->second.value << "\n";
+
+    ft::map<int, int, std::less<int>, counted_allocator<ft::pair<const int, int> > > counted_map;
+    ft::map<int, int, std::less<int>, counted_allocator<ft::pair<const int, int> > > counted_copy(counted_map);
+    counted_copy.swap(counted_map);
+    counted_map.clear();
+    std::cout << allocation_count << " " << counted_map.size() << " " << (counted_copy.begin() == counted_copy.end()) << " ";
+    counted_map[1] = 1;
+    std::cout << (allocation_count > 0) << " " << (sizeof(ft::map<int, int>::iterator) == sizeof(void*)) << "\n";
+  }
+
+
+  std::cout << "============================================================\n"
+            << "              compact, plain node layout test               \n"
+            << "============================================================\n";
+
+  {
+    std::cout << (sizeof(ft::TreeNode<ft::pair<const int, int>, ft::CompactTreeNodeBase>)
+                  < sizeof(ft::TreeNode<ft::pair<const int, int>, ft::TreeNodeBase>)) << " ";
+    ft::map<short, int> plain_map;
+    ft::map<int, int> compact_map;
+    for (int i = 0; i < 2000; i++) {
+      plain_map[static_cast<short>((i * 733) % 2000)] = i;
+      compact_map[(i * 733) % 2000] = i;
+    }
+    for (int i = 0; i < 2000; i += 3) {
+      plain_map.erase(static_cast<short>(i));
+      compact_map.erase(compact_map.find(i));
+    }
+    plain_map.erase(plain_map.lower_bound(500), plain_map.lower_bound(900));
+    compact_map.erase(compact_map.lower_bound(500), compact_map.lower_bound(900));
+    long plain_sum = 0;
+    long compact_sum = 0;
+    ft::map<short, int>::iterator plain_it = plain_map.begin();
+    for (ft::map<int, int>::iterator it = compact_map.begin(); it != compact_map.end(); it++, plain_it++) {
+      plain_sum += plain_it->first * 3 + plain_it->second;
+      compact_sum += it->first * 3 + it->second;
+    }
+    std::cout << plain_map.size() << " " << compact_map.size() << " " << plain_sum << " " << compact_sum << " "
+              << (plain_it == plain_map.end()) << "\n";
+    ft::map<short, int> plain_right;
+    plain_map.split(1500, plain_right);
+    plain_right.erase(plain_right.begin());
+    plain_map.join(plain_right);
+    ft::map<short, int> plain_copy = plain_map;
+    for (ft::map<short, int>::reverse_iterator rit = plain_copy.rbegin(); rit != plain_copy.rend() && rit->first > 1980; rit++)
+      std::cout << rit->first << ", " << rit->second << " ";
+    std::cout << plain_copy.size() << " " << plain_copy.count(1501) << " " << plain_copy.count(1502) << "\n";
+  }
+
+
+  std::cout << "============================================================\n"
+            << "                   map sorted build test                    \n"
+            << "============================================================\n";
+
+  {
+    const int build_sizes[] = { 0, 1, 2, 3, 7, 8, 15, 100 };
+    for (int s = 0; s < 8; s++) {
+      int n = build_sizes[s];
+      ft::vector<ft::pair<int, int> > sorted_input;
+      for (int i = 0; i < n; i++)
+        sorted_input.push_back(ft::make_pair(i * 2, i));
+      compare_count = 0;
+      ft::map<int, int, counted_less> tagged_build(ft::sorted_unique, sorted_input.begin(), sorted_input.end());
+      std::cout << n << ": " << compare_count << " ";
+      compare_count = 0;
+      ft::map<int, int, counted_less> checked_build(sorted_input.begin(), sorted_input.end());
+      std::cout << compare_count << " ";
+      for (int i = 0; i < n; i++)
+        tagged_build[i * 2 + 1] = -i;
+      for (int i = 0; i < n; i += 2)
+        checked_build.erase(i * 2);
+      long build_sum = 0;
+      for (ft::map<int, int, counted_less>::iterator it = tagged_build.begin(); it != tagged_build.end(); it++)
+        build_sum += it->first * it->second;
+      for (ft::map<int, int, counted_less>::reverse_iterator rit = checked_build.rbegin(); rit != checked_build.rend(); rit++)
+        build_sum += rit->first;
+      std::cout << tagged_build.size() << " " << checked_build.size() << " " << build_sum << " / ";
+    }
+    std::cout << "\n";
+
+    ft::pair<int, int> unsorted_input[] = { ft::make_pair(5, 0), ft::make_pair(1, 1), ft::make_pair(5, 2), ft::make_pair(3, 3) };
+    ft::map<int, int> unsorted_build(unsorted_input, unsorted_input + 4);
+    ft::map<int, int> sorted_into;
+    sorted_into.insert(ft::sorted_unique, unsorted_input + 1, unsorted_input + 2);
+    sorted_into.insert(ft::sorted_unique, unsorted_input + 3, unsorted_input + 4);
+    for (ft::map<int, int>::iterator it = unsorted_build.begin(); it != unsorted_build.end(); it++)
+      std::cout << it->first << ", " << it->second << " ";
+    std::cout << sorted_into.size() << " " << sorted_into.rbegin()->first << "\n";
+  }
+
+
+  std::cout << "============================================================\n"
+            << "                    map hint insert test                    \n"
+            << "============================================================\n";
+
+  {
+    ft::map<int, int, counted_less> hinted;
+    compare_count = 0;
+    for (int i = 0; i < 1000; i++)
+      hinted.insert(hinted.end(), ft::make_pair(i * 4, i));
+    std::cout << hinted.size() << " " << compare_count << " ";
+    int hint_compares = 0;
+    for (int i = 1; i < 200; i++) {
+      ft::map<int, int, counted_less>::iterator hint = hinted.find((i / 2) * 4);
+      compare_count = 0;
+      hinted.insert(hint, ft::make_pair((i / 2) * 4 + (i % 2 == 0 ? -1 : 1), -i));
+      hint_compares += compare_count;
+    }
+    std::cout << hinted.size() << " " << hint_compares << "\n";
+
+    ft::map<int, int, counted_less>::iterator hint_result = hinted.insert(hinted.begin(), ft::make_pair(-5, 5));
+    std::cout << hint_result->first << " " << hinted.begin()->first << " ";
+    hint_result = hinted.insert(hinted.begin(), ft::make_pair(2000, 1));
+    std::cout << hint_result->first << ", " << hint_result->second << " ";
+    hint_result = hinted.insert(hinted.find(400), ft::make_pair(12, 1));
+    std::cout << hint_result->first << ", " << hint_result->second << " ";
+    hint_result = hinted.insert(hinted.end(), ft::make_pair(3995, 7));
+    std::cout << hint_result->first << ", " << hint_result->second << " ";
+    std::cout << (++hint_result)->first << " ";
+    hint_result = hinted.insert(hinted.end(), ft::make_pair(5000, 8));
+    std::cout << hint_result->first << " " << hinted.rbegin()->first << " " << hinted.size() << "\n";
+    for (ft::map<int, int, counted_less>::iterator it = hinted.begin(); it != hinted.lower_bound(12); it++)
+      std::cout << it->first << ", " << it->second << " ";
+    std::cout << "\n";
+  }
+
+
+  std::cout << "============================================================\n"
+            << "                       map clone test                       \n"
+            << "============================================================\n";
+
+  {
+    ft::map<int, int, counted_less> clone_source;
+    for (int i = 0; i < 500; i++)
+      clone_source[(i * 211) % 500] = i;
+    ft::map<int, int, counted_less> empty_source;
+    ft::map<int, int, counted_less> assigned_clone;
+    for (int i = 0; i < 50; i++)
+      assigned_clone[-i] = i;
+    compare_count = 0;
+    ft::map<int, int, counted_less> cloned(clone_source);
+    ft::map<int, int, counted_less> empty_clone(empty_source);
+    assigned_clone = clone_source;
+    ft::map<int, int, counted_less> self_assigned(cloned);
+    const ft::map<int, int, counted_less>& self_reference = self_assigned;
+    self_assigned = self_reference;
+    empty_clone = empty_source;
+    std::cout << compare_count << " " << cloned.size() << " " << empty_clone.size() << " " << assigned_clone.size() << " "
+              << self_assigned.size() << "\n";
+
+    cloned.erase(cloned.begin(), cloned.find(100));
+    assigned_clone[1000] = 1;
+    self_assigned.erase(250);
+    long clone_sum = 0;
+    for (ft::map<int, int, counted_less>::iterator it = clone_source.begin(); it != clone_source.end(); it++)
+      clone_sum += it->first * it->second;
+    std::cout << clone_source.size() << " " << clone_sum << " " << cloned.size() << " " << cloned.begin()->first << " "
+              << assigned_clone.rbegin()->first << " " << self_assigned.count(250) << " " << clone_source.count(250) << "\n";
+
+    ft::map<long, int> threaded_source;
+    ft::map<short, int> plain_source;
+    for (int i = 0; i < 40; i++) {
+      threaded_source[i * 3] = i;
+      plain_source[static_cast<short>(i * 5)] = i;
+    }
+    ft::map<long, int> threaded_clone(threaded_source);
+    ft::map<short, int> plain_clone;
+    plain_clone = plain_source;
+    threaded_clone.erase(threaded_clone.find(60));
+    for (ft::map<long, int>::reverse_iterator rit = threaded_clone.rbegin(); rit != threaded_clone.rend() && rit->first > 50; rit++)
+      std::cout << rit->first << " ";
+    for (ft::map<long, int>::iterator it = threaded_clone.lower_bound(55); it != threaded_clone.lower_bound(70); it++)
+      std::cout << it->first << " ";
+    std::cout << threaded_clone.size() << " " << (plain_clone == plain_source) << " " << plain_clone.rbegin()->first << "\n";
+  }
+
   return (0);
 }
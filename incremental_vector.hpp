@@ -0,0 +1,651 @@
+#ifndef INCREMENTAL_VECTOR_HPP_
+# define INCREMENTAL_VECTOR_HPP_
+
+/*
+** incremental_vector
+** capacity가 가득 찼을 때 기존 element를 한 번에 옮기지 않고, 새 버퍼와 기존 버퍼를 함께 들고 있으면서
+** 이후 연산마다 정해진 수(migration_step)만큼씩 새 버퍼로 옮기는 벡터이다.
+** push_back 한 번에 하는 일이 element 수와 상관없이 제한되므로, 큰 버퍼를 재할당할 때 생기는 지연이 없다.
+** 옮기는 중에는 element가 두 버퍼에 나뉘어 있으므로 연속된 메모리를 보장하지 않고,
+** iterator는 포인터 대신 index로 element를 찾는다.
+*/
+
+# include <cstddef>    // std::size_t, std::ptrdiff_t
+# include <memory>     // std::allocator
+# include <stdexcept>  // std::length_error, std::out_of_range
+# include "utils/iterator.hpp"
+# include "utils/algorithm.hpp"
+# include "utils/memory.hpp"
+# include "utils/type_traits.hpp"
+
+namespace ft {
+  /*
+  ** index_iterator
+  ** 컨테이너와 index를 들고 operator[]로 element에 접근하는 random access iterator이다.
+  */
+  template <class Container, class Value>
+  class index_iterator : public iterator<random_access_iterator_tag, Value> {
+    public:
+    typedef typename iterator<random_access_iterator_tag, Value>::value_type          value_type;
+    typedef typename iterator<random_access_iterator_tag, Value>::difference_type     difference_type;
+    typedef typename iterator<random_access_iterator_tag, Value>::pointer             pointer;
+    typedef typename iterator<random_access_iterator_tag, Value>::reference           reference;
+    typedef typename iterator<random_access_iterator_tag, Value>::iterator_category   iterator_category;
+
+    protected:
+    Container*        _container;
+    difference_type   _idx;
+
+    public:
+    index_iterator(void)                                : _container(NULL), _idx(0) {}
+    index_iterator(Container* container, difference_type idx) : _container(container), _idx(idx) {}
+
+    operator index_iterator<const Container, const Value>() const {
+      return (index_iterator<const Container, const Value>(_container, _idx));
+    }
+
+    Container*      container(void) const { return (_container); }
+    difference_type index(void) const     { return (_idx); }
+
+    reference operator* (void) const              { return ((*_container)[_idx]); }
+    pointer   operator->(void) const              { return (&(operator*())); }
+    reference operator[](difference_type n) const { return ((*_container)[_idx + n]); }
+
+    index_iterator operator+(difference_type n) const { return (index_iterator(_container, _idx + n)); }
+    index_iterator operator-(difference_type n) const { return (index_iterator(_container, _idx - n)); }
+
+    index_iterator& operator++(void) {
+      ++_idx;
+      return (*this);
+    }
+    index_iterator operator++(int) {
+      index_iterator tmp(*this);
+      _idx++;
+      return (tmp);
+    }
+    index_iterator& operator--(void) {
+      --_idx;
+      return (*this);
+    }
+    index_iterator operator--(int) {
+      index_iterator tmp(*this);
+      _idx--;
+      return (tmp);
+    }
+
+    index_iterator& operator+=(difference_type n) {
+      _idx += n;
+      return (*this);
+    }
+    index_iterator& operator-=(difference_type n) {
+      _idx -= n;
+      return (*this);
+    }
+  };
+
+  template <class C1, class V1, class C2, class V2>
+  bool operator==(const index_iterator<C1, V1>& lhs, const index_iterator<C2, V2>& rhs) { return (lhs.index() == rhs.index()); }
+  template <class C1, class V1, class C2, class V2>
+  bool operator!=(const index_iterator<C1, V1>& lhs, const index_iterator<C2, V2>& rhs) { return (lhs.index() != rhs.index()); }
+  template <class C1, class V1, class C2, class V2>
+  bool operator< (const index_iterator<C1, V1>& lhs, const index_iterator<C2, V2>& rhs) { return (lhs.index() < rhs.index()); }
+  template <class C1, class V1, class C2, class V2>
+  bool operator> (const index_iterator<C1, V1>& lhs, const index_iterator<C2, V2>& rhs) { return (lhs.index() > rhs.index()); }
+  template <class C1, class V1, class C2, class V2>
+  bool operator<=(const index_iterator<C1, V1>& lhs, const index_iterator<C2, V2>& rhs) { return (lhs.index() <= rhs.index()); }
+  template <class C1, class V1, class C2, class V2>
+  bool operator>=(const index_iterator<C1, V1>& lhs, const index_iterator<C2, V2>& rhs) { return (lhs.index() >= rhs.index()); }
+
+  template <class C, class V>
+  index_iterator<C, V> operator+(typename index_iterator<C, V>::difference_type n, const index_iterator<C, V>& it) {
+    return (it + n);
+  }
+  template <class C1, class V1, class C2, class V2>
+  typename index_iterator<C1, V1>::difference_type operator-(const index_iterator<C1, V1>& lhs, const index_iterator<C2, V2>& rhs) {
+    return (lhs.index() - rhs.index());
+  }
+
+  template < class T, class Alloc = std::allocator<T> >
+  class incremental_vector {
+    public:
+    /* ============================================================ */
+    /*                                                              */
+    /*                         Member types                         */
+    /*                                                              */
+    /* ============================================================ */
+    typedef T                                                         value_type;
+    typedef Alloc                                                     allocator_type;
+    typedef typename allocator_type::reference                        reference;                // T&
+    typedef typename allocator_type::const_reference                  const_reference;          // const T&
+    typedef typename allocator_type::pointer                          pointer;                  // T*
+    typedef typename allocator_type::const_pointer                    const_pointer;            // const T*
+    typedef ft::index_iterator<incremental_vector, value_type>              iterator;
+    typedef ft::index_iterator<const incremental_vector, const value_type>  const_iterator;
+    typedef ft::reverse_iterator<iterator>                            reverse_iterator;
+    typedef ft::reverse_iterator<const_iterator>                      const_reverse_iterator;
+    typedef typename ft::iterator_traits<iterator>::difference_type   difference_type;          // ptrdiff_t
+    typedef typename allocator_type::size_type                        size_type;                // size_t
+
+    static const size_type default_migration_step = 32;
+
+    private:
+    /*
+    ** element i의 위치
+    ** - i < _migrated 또는 i >= _old_size : _ptr[i] (새 버퍼)
+    ** - _migrated <= i < _old_size        : _old[i] (아직 옮기지 않은 기존 버퍼)
+    ** 옮기는 중이 아니면 _old는 NULL이고 _migrated와 _old_size는 0이다.
+    */
+    allocator_type    _alloc;
+    pointer           _ptr;       // 새 버퍼
+    size_type         _capacity;  // 새 버퍼의 사이즈
+    size_type         _size;      // 실제로 담겨 있는 데이터의 수
+    pointer           _old;       // 옮기는 중인 기존 버퍼
+    size_type         _old_capacity;
+    size_type         _old_size;  // 기존 버퍼에 있던 element의 수
+    size_type         _migrated;  // 새 버퍼로 옮긴 element의 수
+    size_type         _step;      // 연산 한 번마다 옮길 element의 수
+
+    public:
+    /* ============================================================ */
+    /*                                                              */
+    /*                       Member functions                       */
+    /*                                                              */
+    /* ============================================================ */
+
+    /* Constructor (1) default */
+    explicit incremental_vector(const allocator_type& alloc = allocator_type())
+      : _alloc(alloc), _ptr(NULL), _capacity(0), _size(0),
+        _old(NULL), _old_capacity(0), _old_size(0), _migrated(0), _step(default_migration_step) {}
+    /* Constructor (2) fill */
+    explicit incremental_vector(size_type n, const value_type& val = value_type(), const allocator_type& alloc = allocator_type())
+      : _alloc(alloc), _ptr(NULL), _capacity(0), _size(0),
+        _old(NULL), _old_capacity(0), _old_size(0), _migrated(0), _step(default_migration_step) {
+        try {
+          resize(n, val);
+        } catch (...) {
+          release();
+          throw ;
+        }
+      }
+    /* Constructor (3) range */
+    template <class InputIterator>
+    incremental_vector(InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type(),
+      typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL)
+      : _alloc(alloc), _ptr(NULL), _capacity(0), _size(0),
+        _old(NULL), _old_capacity(0), _old_size(0), _migrated(0), _step(default_migration_step) {
+        try {
+          for (; first != last; ++first)
+            push_back(*first);
+        } catch (...) {
+          release();
+          throw ;
+        }
+      }
+    /* Constructor (4) copy */
+    incremental_vector(const incremental_vector& x)
+      : _alloc(x._alloc), _ptr(NULL), _capacity(0), _size(0),
+        _old(NULL), _old_capacity(0), _old_size(0), _migrated(0), _step(x._step) {
+        try {
+          *this = x;
+        } catch (...) {
+          release();
+          throw ;
+        }
+      }
+
+    /* Destructor */
+    ~incremental_vector() {
+      release();
+    }
+
+    /*
+    ** Assign content
+    ** 재할당하는 경우 현재 allocator를 유지한다.
+    */
+    incremental_vector& operator=(const incremental_vector& x) {
+      if (this != &x) {
+        clear();
+        reserve(x._size);
+        for (size_type i = 0; i < x._size; i++)
+          push_back(x[i]);
+      }
+      return (*this);
+    }
+
+    /* ============================================================ */
+    /*                          Iterators                           */
+    /* ============================================================ */
+
+    iterator begin() {
+      return (iterator(this, 0));
+    }
+    const_iterator begin() const {
+      return (const_iterator(this, 0));
+    }
+
+    iterator end() {
+      return (iterator(this, _size));
+    }
+    const_iterator end() const {
+      return (const_iterator(this, _size));
+    }
+
+    reverse_iterator rbegin() {
+      return (reverse_iterator(end()));
+    }
+    const_reverse_iterator rbegin() const {
+      return (const_reverse_iterator(end()));
+    }
+
+    reverse_iterator rend() {
+      return (reverse_iterator(begin()));
+    }
+    const_reverse_iterator rend() const {
+      return (const_reverse_iterator(begin()));
+    }
+
+    /* ============================================================ */
+    /*                           Capacity                           */
+    /* ============================================================ */
+
+    size_type size() const {
+      return (_size);
+    }
+
+    size_type max_size() const {
+      return (_alloc.max_size());
+    }
+
+    void resize(size_type n, value_type val = value_type()) {
+      while (_size > n)
+        pop_back();
+      if (n > _capacity)
+        reserve(n);
+      while (_size < n)
+        push_back(val);
+    }
+
+    /* 새 버퍼의 capacity를 반환한다. */
+    size_type capacity() const {
+      return (_capacity);
+    }
+
+    bool empty() const {
+      return (_size == 0);
+    }
+
+    /*
+    ** Request a change in capacity
+    ** 명시적으로 요청한 재할당이므로 남은 이동을 끝낸 뒤 모든 element를 한 번에 옮긴다.
+    */
+    void reserve(size_type n) {
+      if (n > max_size())
+        throw (std::length_error("ft::incremental_vector::reserve"));
+      if (n <= _capacity)
+        return ;
+      finish_migration();
+      pointer new_ptr = _alloc.allocate(n);
+      try {
+        ft::relocate(_alloc, _ptr, _ptr + _size, new_ptr);
+      } catch (...) {
+        _alloc.deallocate(new_ptr, n);
+        throw ;
+      }
+      if (_capacity > 0)
+        _alloc.deallocate(_ptr, _capacity);
+      _ptr = new_ptr;
+      _capacity = n;
+    }
+
+    /* ============================================================ */
+    /*                      Incremental growth                      */
+    /* ============================================================ */
+
+    /* 기존 버퍼에서 옮기지 않은 element가 남아 있는지 확인한다. */
+    bool migrating() const {
+      return (_old != NULL);
+    }
+
+    /*
+    ** Migration step
+    ** push_back, pop_back이 한 번 호출될 때마다 기존 버퍼에서 옮길 element의 수이다. 0은 1로 취급한다.
+    ** capacity를 두 배씩 늘리므로 1 이상이면 새 버퍼가 가득 차기 전에 이동이 끝난다.
+    */
+    size_type migration_step() const {
+      return (_step);
+    }
+    void set_migration_step(size_type step) {
+      _step = step;
+    }
+
+    /* 남은 element를 모두 새 버퍼로 옮기고 기존 버퍼를 해제한다. */
+    void finish_migration() {
+      if (migrating())
+        migrate(_old_size - _migrated);
+    }
+
+    /* ============================================================ */
+    /*                        Element access                        */
+    /* ============================================================ */
+
+    reference operator[](size_type n) {
+      return ((n < _migrated || n >= _old_size) ? _ptr[n] : _old[n]);
+    }
+    const_reference operator[](size_type n) const {
+      return ((n < _migrated || n >= _old_size) ? _ptr[n] : _old[n]);
+    }
+
+    reference at(size_type n) {
+      if (n >= _size)
+        throw (std::out_of_range("ft::incremental_vector::at"));
+      return ((*this)[n]);
+    }
+    const_reference at(size_type n) const {
+      if (n >= _size)
+        throw (std::out_of_range("ft::incremental_vector::at"));
+      return ((*this)[n]);
+    }
+
+    reference front() {
+      return ((*this)[0]);
+    }
+    const_reference front() const {
+      return ((*this)[0]);
+    }
+
+    reference back() {
+      return ((*this)[_size - 1]);
+    }
+    const_reference back() const {
+      return ((*this)[_size - 1]);
+    }
+
+    /* ============================================================ */
+    /*                          Modifiers                           */
+    /* ============================================================ */
+
+    /*
+    ** Assign vector content
+    ** 기존 element를 모두 제거하고 새 컨텐츠로 채운다. 새 버퍼의 capacity는 유지한다.
+    */
+    template <class InputIterator>
+    void assign(InputIterator first, InputIterator last,
+      typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL) {
+        clear();
+        for (; first != last; ++first)
+          push_back(*first);
+      }
+    void assign(size_type n, const value_type& val) {
+      value_type tmp(val);
+      clear();
+      reserve(n);
+      for (size_type i = 0; i < n; i++)
+        push_back(tmp);
+    }
+
+    /*
+    ** Add element at the end
+    ** capacity가 가득 찼다면 두 배 크기의 새 버퍼를 할당하고 val만 새 버퍼에 생성한다.
+    ** 기존 element는 이후 연산마다 migration_step개씩 옮긴다.
+    ** val이 기존 element를 가리킬 수 있으므로 val을 먼저 생성하고 옮기며,
+    ** 옮기다가 예외가 발생하면 생성한 element와 새로 할당한 버퍼를 되돌려 호출 전 상태로 남긴다.
+    */
+    void push_back(const value_type& val) {
+      bool grew = (_size == _capacity);
+      if (grew) {
+        grow(val);
+      } else {
+        _alloc.construct(_ptr + _size, val);
+        _size++;
+      }
+      if (migrating()) {
+        try {
+          migrate(_step);
+        } catch (...) {
+          undo_push_back(grew);
+          throw ;
+        }
+      }
+    }
+
+    void pop_back() {
+      if (_size == 0) return ;
+      _alloc.destroy(&(*this)[_size - 1]);
+      _size--;
+      if (_old_size > _size)
+        _old_size = _size;
+      if (_migrated > _size)
+        _migrated = _size;
+      if (migrating())
+        migrate(_step);
+    }
+
+    /*
+    ** Insert elements
+    ** 끝에 삽입할 때는 push_back과 같이 옮기는 일을 나눠서 한다.
+    ** 중간에 삽입할 때는 어차피 뒤쪽 element를 모두 밀어야 하므로 남은 이동을 끝내고 한 버퍼 안에서 삽입한다.
+    */
+    iterator insert(iterator position, const value_type& val) {
+      size_type idx = position.index();
+      insert(position, 1, val);
+      return (begin() + idx);
+    }
+    void insert(iterator position, size_type n, const value_type& val) {
+      size_type idx = position.index();
+      if (n == 0) return ;
+      value_type tmp(val);
+      if (idx == _size) {
+        for (size_type i = 0; i < n; i++)
+          push_back(tmp);
+        return ;
+      }
+      finish_migration();
+      if (n > _capacity - _size)
+        reserve(next_capacity(_size + n));
+      ft::buffer_insert_fill(_alloc, _ptr, _size, idx, n, tmp);
+    }
+    template <class InputIterator>
+    void insert(iterator position, InputIterator first, InputIterator last,
+      typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL) {
+        size_type idx = position.index();
+        if (idx == _size) {
+          for (; first != last; ++first)
+            push_back(*first);
+          return ;
+        }
+        incremental_vector tmp(first, last, _alloc);
+        if (tmp.empty()) return ;
+        tmp.finish_migration();
+        finish_migration();
+        if (tmp._size > _capacity - _size)
+          reserve(next_capacity(_size + tmp._size));
+        ft::buffer_insert_range(_alloc, _ptr, _size, idx, tmp._ptr, tmp._ptr + tmp._size, tmp._size);
+      }
+
+    /*
+    ** Erase elements
+    ** 끝에서 지울 때는 pop_back과 같이 옮기는 일을 나눠서 하고, 중간에서 지울 때는 남은 이동을 끝낸 뒤 당긴다.
+    */
+    iterator erase(iterator position) {
+      if (empty()) return (end());
+      return (erase(position, position + 1));
+    }
+    iterator erase(iterator first, iterator last) {
+      size_type idx = first.index();
+      size_type n = last - first;
+      if (n == 0) return (begin() + idx);
+      if (idx + n == _size) {
+        while (_size > idx)
+          pop_back();
+      } else {
+        finish_migration();
+        ft::buffer_erase(_alloc, _ptr, _size, idx, n);
+      }
+      return (begin() + idx);
+    }
+
+    /* Swap content */
+    void swap(incremental_vector& x) {
+      swap_value(_alloc, x._alloc);
+      swap_value(_ptr, x._ptr);
+      swap_value(_capacity, x._capacity);
+      swap_value(_size, x._size);
+      swap_value(_old, x._old);
+      swap_value(_old_capacity, x._old_capacity);
+      swap_value(_old_size, x._old_size);
+      swap_value(_migrated, x._migrated);
+      swap_value(_step, x._step);
+    }
+
+    /* 모든 element를 제거한다. 기존 버퍼는 해제하고, 새 버퍼의 capacity는 유지한다. */
+    void clear() {
+      while (_size > 0)
+        pop_back();
+      finish_migration();
+    }
+
+    /* ============================================================ */
+    /*                          Allocator                           */
+    /* ============================================================ */
+
+    allocator_type get_allocator() const {
+      return (_alloc);
+    }
+
+    private:
+    template <class U>
+    static void swap_value(U& a, U& b) {
+      U tmp = a;
+      a = b;
+      b = tmp;
+    }
+
+    /* 모든 element를 파괴하고 두 버퍼를 해제한다. */
+    void release() {
+      clear();
+      if (_capacity > 0)
+        _alloc.deallocate(_ptr, _capacity);
+      _ptr = NULL;
+      _capacity = 0;
+    }
+
+    /*
+    ** 기존 버퍼에서 n개까지 새 버퍼로 옮긴다. 모두 옮기면 기존 버퍼를 해제한다.
+    ** 옮기는 중 예외가 발생하면 그 묶음의 element는 기존 버퍼에 그대로 남는다.
+    */
+    void migrate(size_type n) {
+      if (n == 0) n = 1;
+      size_type last = (_old_size - _migrated > n) ? _migrated + n : _old_size;
+      ft::relocate(_alloc, _old + _migrated, _old + last, _ptr + _migrated);
+      _migrated = last;
+      if (_migrated == _old_size) {
+        _alloc.deallocate(_old, _old_capacity);
+        _old = NULL;
+        _old_capacity = 0;
+        _old_size = 0;
+        _migrated = 0;
+      }
+    }
+
+    /* 두 배씩 늘리되 n개보다 작지 않은 capacity를 계산한다. */
+    size_type next_capacity(size_type n) const {
+      size_type max = max_size();
+      if (n > max)
+        throw (std::length_error("ft::incremental_vector"));
+      if (_capacity >= max / 2)
+        return (max);
+      return (_capacity * 2 < n ? n : _capacity * 2);
+    }
+
+    /*
+    ** push_back이 옮기다가 실패했을 때 마지막 element를 파괴한다.
+    ** grow로 버퍼를 바꾼 직후라면 아직 아무것도 옮기지 않았으므로 새 버퍼를 해제하고 기존 버퍼로 돌아간다.
+    */
+    void undo_push_back(bool grew) {
+      _size--;
+      _alloc.destroy(_ptr + _size);
+      if (grew) {
+        _alloc.deallocate(_ptr, _capacity);
+        _ptr = _old;
+        _capacity = _old_capacity;
+        _old = NULL;
+        _old_capacity = 0;
+        _old_size = 0;
+        _migrated = 0;
+      }
+    }
+
+    /*
+    ** 새 버퍼를 할당하고 val을 생성한 뒤, 지금의 버퍼를 옮길 대상으로 넘긴다.
+    ** 이전 이동이 남아 있다면(migration_step이 너무 작게 바뀐 경우) 먼저 끝낸다.
+    ** val이 기존 element를 가리킬 수 있으므로 버퍼를 넘기기 전에 새 버퍼에 먼저 생성한다.
+    */
+    void grow(const value_type& val) {
+      finish_migration();
+      size_type max = max_size();
+      if (_size + 1 > max)
+        throw (std::length_error("ft::incremental_vector"));
+      size_type new_capacity = (_capacity == 0) ? 1 : (_capacity >= max / 2 ? max : _capacity * 2);
+      pointer new_ptr = _alloc.allocate(new_capacity);
+      try {
+        _alloc.construct(new_ptr + _size, val);
+      } catch (...) {
+        _alloc.deallocate(new_ptr, new_capacity);
+        throw ;
+      }
+      if (_size == 0) {
+        if (_capacity > 0)
+          _alloc.deallocate(_ptr, _capacity);
+      } else {
+        _old = _ptr;
+        _old_capacity = _capacity;
+        _old_size = _size;
+        _migrated = 0;
+      }
+      _ptr = new_ptr;
+      _capacity = new_capacity;
+      _size++;
+    }
+  };
+
+  template <class T, class Alloc>
+  const typename incremental_vector<T, Alloc>::size_type incremental_vector<T, Alloc>::default_migration_step;
+
+  /* ============================================================ */
+  /*                                                              */
+  /*                Non-member function overloads                 */
+  /*                                                              */
+  /* ============================================================ */
+
+  template <class T, class Alloc>
+  bool operator==(const incremental_vector<T, Alloc>& lhs, const incremental_vector<T, Alloc>& rhs) {
+    return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+  }
+  template <class T, class Alloc>
+  bool operator!=(const incremental_vector<T, Alloc>& lhs, const incremental_vector<T, Alloc>& rhs) {
+    return (!(lhs == rhs));
+  }
+  template <class T, class Alloc>
+  bool operator< (const incremental_vector<T, Alloc>& lhs, const incremental_vector<T, Alloc>& rhs) {
+    return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+  }
+  template <class T, class Alloc>
+  bool operator<=(const incremental_vector<T, Alloc>& lhs, const incremental_vector<T, Alloc>& rhs) {
+    return (!(rhs < lhs));
+  }
+  template <class T, class Alloc>
+  bool operator> (const incremental_vector<T, Alloc>& lhs, const incremental_vector<T, Alloc>& rhs) {
+    return (rhs < lhs);
+  }
+  template <class T, class Alloc>
+  bool operator>=(const incremental_vector<T, Alloc>& lhs, const incremental_vector<T, Alloc>& rhs) {
+    return (!(lhs < rhs));
+  }
+
+  template <class T, class Alloc>
+  void swap(incremental_vector<T, Alloc>& x, incremental_vector<T, Alloc>& y) {
+    x.swap(y);
+  }
+}
+
+#endif
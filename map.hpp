@@ -23,19 +23,22 @@ namespace ft {
     typedef Compare                                                       key_compare;
     typedef Alloc                                                         allocator_type;
     typedef typename allocator_type::template rebind<value_type>::other   type_allocator;
-    typedef std::allocator_traits<type_allocator>                         type_traits;
-    typedef typename type_traits::pointer                                 pointer;
-    typedef typename type_traits::const_pointer                           const_pointer;
+    typedef typename type_allocator::pointer                              pointer;
+    typedef typename type_allocator::const_pointer                        const_pointer;
     typedef value_type&                                                   reference;
     typedef const value_type&                                             const_reference;
     typedef std::size_t                                                   size_type;
     typedef std::ptrdiff_t                                                difference_type;
 
-    class value_compare : public std::binary_function<value_type, value_type, bool> {
+    class value_compare {
       protected:
       key_compare comp;
 
       public:
+      typedef bool        result_type;
+      typedef value_type  first_argument_type;
+      typedef value_type  second_argument_type;
+
       value_compare(key_compare c) : comp(c) {}
       ~value_compare() {}
 
@@ -54,6 +57,7 @@ namespace ft {
     typedef typename ft::rbtree<value_type, key_type, value_compare, allocator_type>::const_iterator  const_iterator;
     typedef ft::reverse_iterator<iterator>        reverse_iterator;
     typedef ft::reverse_iterator<const_iterator>  const_reverse_iterator;
+    typedef typename ft::rbtree<value_type, key_type, value_compare, allocator_type>::pool_type       node_pool_type;
 
     private:
     key_compare     _key_comp;
@@ -70,12 +74,29 @@ namespace ft {
     /* Constructor (1) empty */
     explicit map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
       : _key_comp(comp), _value_comp(comp), _tree(_value_comp, alloc) {}
+    /*
+    ** Constructor (1) empty, with node pool
+    ** node를 pool에서 할당한다. 같은 node_pool_type을 쓰는 map끼리 pool 하나를 공유할 수 있고,
+    ** pool은 그 pool을 사용하는 map이 모두 소멸한 뒤에 소멸해야 한다.
+    */
+    explicit map(node_pool_type& pool, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+      : _key_comp(comp), _value_comp(comp), _tree(_value_comp, alloc, &pool) {}
     /* Constructor (2) range */
     template <class InputIterator>
     map(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
       : _key_comp(comp), _value_comp(comp), _tree(_value_comp, alloc) {
         insert(first, last);
       }
+    /*
+    ** Constructor (2) range, sorted unique
+    ** [first, last)가 키 순서로 정렬되어 있고 중복된 키가 없을 때 검사 없이 O(n)에 tree를 만든다.
+    ** 일반 range 생성자도 forward iterator 범위가 정렬되어 있으면 같은 방식으로 만든다.
+    */
+    template <class InputIterator>
+    map(ft::sorted_unique_t, InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+      : _key_comp(comp), _value_comp(comp), _tree(_value_comp, alloc) {
+        insert(ft::sorted_unique, first, last);
+      }
     /* Constructor (3) copy */
     map(const map& x)
       : _key_comp(x._key_comp), _value_comp(x._value_comp), _tree(x._tree) {}
@@ -118,7 +139,7 @@ namespace ft {
       return (reverse_iterator(end()));
     }
     const_reverse_iterator rbegin() const {
-      return (reverse_iterator(end()));
+      return (const_reverse_iterator(end()));
     }
 
     /* Return reverse iterator to reverse end */
@@ -126,7 +147,7 @@ namespace ft {
       return (reverse_iterator(begin()));
     }
     const_reverse_iterator rend() const {
-      return (reverse_iterator(begin()));
+      return (const_reverse_iterator(begin()));
     }
 
     /* ============================================================ */
@@ -207,6 +228,22 @@ namespace ft {
     void insert(InputIterator first, InputIterator last) {
       return (_tree.insert(first, last));
     }
+    /*
+    ** Insert element (3) range, sorted unique
+    ** 빈 map이면 정렬된 범위로 tree를 O(n)에 만들고, 비어 있지 않으면 하나씩 삽입한다.
+    */
+    template <class InputIterator>
+    void insert(ft::sorted_unique_t, InputIterator first, InputIterator last) {
+      _tree.insert(ft::sorted_unique, first, last);
+    }
+    /*
+    ** Insert element, batch
+    ** 정렬되지 않은 범위를 한 번에 넣는다. 범위를 정렬한 뒤 직전에 넣은 위치에서부터 찾아 넣으므로, 큰 map에 많은 element를 넣을 때 insert(first, last)보다 빠르다.
+    */
+    template <class InputIterator>
+    void insert_batch(InputIterator first, InputIterator last) {
+      _tree.insert_batch(first, last);
+    }
 
     /* Erase element (1) single element */
     void erase(iterator position) {
@@ -223,6 +260,16 @@ namespace ft {
     void erase(iterator first, iterator last) {
       _tree.erase(first, last);
     }
+    /*
+    ** Erase element, key range
+    ** key가 [lower, upper) 범위에 있는 element를 모두 지우고 지운 element의 수를 반환한다.
+    ** upper가 lower보다 크지 않으면 아무것도 지우지 않는다.
+    */
+    size_type erase(const key_type& lower, const key_type& upper) {
+      if (!_key_comp(lower, upper))
+        return (0);
+      return (_tree.erase(lower_bound(lower), lower_bound(upper)));
+    }
 
     /* Swap content */
     void swap(map& x) {
@@ -234,6 +281,25 @@ namespace ft {
       _tree.clear();
     }
 
+    /*
+    ** Split
+    ** key보다 작은 element는 남기고 나머지를 right로 옮긴다. right에 있던 element는 지워진다.
+    ** node를 그대로 옮기지만 size를 정확히 유지하려고 두 map 중 작은 쪽의 element를 세므로 O(log n + min(k, n - k))이다.
+    ** 따라서 가운데에서 자르면 O(n)이다. node에 subtree 크기를 두지 않아서 생기는 비용이다(ft::rbtree::split 참고).
+    ** 넘겨받은 node_pool_type을 쓰는 map에서 다른 pool을 쓰는 right로 옮길 때만 element를 복사한다.
+    */
+    void split(const key_type& key, map& right) {
+      _tree.split(key, right._tree);
+    }
+    /*
+    ** Join
+    ** right의 element를 모두 이 map 뒤에 붙이고 right를 비운다. right의 모든 key는 이 map의 모든 key보다 커야 한다.
+    ** node를 그대로 옮기므로 O(log n)이다. right가 넘겨받은 node_pool_type을 쓰고 이 map과 pool이 다르면 element를 복사한다.
+    */
+    void join(map& right) {
+      _tree.join(right._tree);
+    }
+
     /* ============================================================ */
     /*                          Observers                           */
     /* ============================================================ */
@@ -0,0 +1,674 @@
+#ifndef SMALL_VECTOR_HPP_
+# define SMALL_VECTOR_HPP_
+
+/*
+** small_vector
+** element가 N개 이하일 때는 객체 안의 저장 공간을 사용하고, N개를 넘어가는 순간 힙으로 옮겨가는 벡터이다.
+** 멤버 함수, iterator, 비교 연산자는 ft::vector와 같고, ft::stack의 Container로도 사용할 수 있다.
+*/
+
+# include <algorithm>  // std::swap
+# include <cstddef>    // std::size_t
+# include <functional> // std::less
+# include <memory>     // std::allocator
+# include <stdexcept>  // std::length_error, std::out_of_range
+# include "utils/iterator.hpp"
+# include "utils/algorithm.hpp"
+# include "utils/memory.hpp"
+# include "utils/type_traits.hpp"
+# if __cplusplus >= 201103L
+#  include <utility>   // std::forward, std::move
+# endif
+
+namespace ft {
+  template < class T, std::size_t N, class Alloc = std::allocator<T> >
+  class small_vector {
+    public:
+    /* ============================================================ */
+    /*                                                              */
+    /*                         Member types                         */
+    /*                                                              */
+    /* ============================================================ */
+    typedef T                                                         value_type;
+    typedef Alloc                                                     allocator_type;
+    typedef typename allocator_type::reference                        reference;                // T&
+    typedef typename allocator_type::const_reference                  const_reference;          // const T&
+    typedef typename allocator_type::pointer                          pointer;                  // T*
+    typedef typename allocator_type::const_pointer                    const_pointer;            // const T*
+    typedef ft::random_access_iterator<value_type>                    iterator;
+    typedef ft::random_access_iterator<const value_type>              const_iterator;
+    typedef ft::reverse_iterator<iterator>                            reverse_iterator;
+    typedef ft::reverse_iterator<const_iterator>                      const_reverse_iterator;
+    typedef typename ft::iterator_traits<iterator>::difference_type   difference_type;          // ptrdiff_t
+    typedef typename allocator_type::size_type                        size_type;                // size_t
+
+    static const size_type inline_capacity = N;
+
+    private:
+    allocator_type                _alloc;
+    pointer                       _ptr;       // 객체 안의 _buffer 또는 힙에 할당한 버퍼
+    size_type                     _capacity;  // 할당된 사이즈, _buffer를 사용 중이면 N
+    size_type                     _size;      // 실제로 담겨 있는 데이터의 수
+    ft::aligned_buffer<T, N>      _buffer;
+
+    public:
+    /* ============================================================ */
+    /*                                                              */
+    /*                       Member functions                       */
+    /*                                                              */
+    /* ============================================================ */
+
+    /*
+    ** Constructor (1) default
+    ** element가 없는 빈 컨테이너를 생성한다. 힙 할당은 일어나지 않는다.
+    */
+    explicit small_vector(const allocator_type& alloc = allocator_type())
+      : _alloc(alloc), _ptr(inline_data()), _capacity(N), _size(0) {}
+    /*
+    ** Constructor (2) fill
+    ** n개의 element를 가지는 컨테이너를 생성하고, 각 element는 val을 복사해 채운다.
+    */
+    explicit small_vector(size_type n, const value_type& val = value_type(), const allocator_type& alloc = allocator_type())
+      : _alloc(alloc), _ptr(inline_data()), _capacity(N), _size(0) {
+        insert(end(), n, val);
+      }
+    /*
+    ** Constructor (3) range
+    ** range[first, last]만큼의 element를 가지는 컨테이너를 생성하고, 각 element는 range와 동일한 순서로 구성된다.
+    */
+    template <class InputIterator>
+    small_vector(InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type(),
+      typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL)
+      : _alloc(alloc), _ptr(inline_data()), _capacity(N), _size(0) {
+        insert(end(), first, last);
+      }
+    /*
+    ** Constructor (4) copy
+    ** x에 있는 각 element의 복사본을 동일한 순서대로 복사하여 컨테이너를 생성한다.
+    */
+    small_vector(const small_vector& x)
+      : _alloc(x._alloc), _ptr(inline_data()), _capacity(N), _size(0) {
+        insert(end(), x.begin(), x.end());
+      }
+# if __cplusplus >= 201103L
+    /*
+    ** Constructor (5) move
+    ** x가 힙 버퍼를 사용 중이라면 버퍼를 넘겨받고, 객체 안의 저장 공간을 사용 중이라면 element를 하나씩 이동한다.
+    */
+    small_vector(small_vector&& x)
+      : _alloc(x._alloc), _ptr(inline_data()), _capacity(N), _size(0) {
+        take(x);
+      }
+# endif
+
+    /*
+    ** Destructor
+    ** 모든 element를 파괴하고, 힙 버퍼를 사용 중이라면 allocator를 사용하여 할당 해제한다.
+    */
+    ~small_vector() {
+      clear();
+      release_buffer();
+    }
+
+    /*
+    ** Assign content
+    ** 재할당하는 경우 현재 allocator를 유지한다.
+    */
+    small_vector& operator=(const small_vector& x) {
+      if (this != &x) {
+        clear();
+        insert(end(), x.begin(), x.end());
+      }
+      return (*this);
+    }
+# if __cplusplus >= 201103L
+    small_vector& operator=(small_vector&& x) {
+      if (this != &x) {
+        clear();
+        take(x);
+      }
+      return (*this);
+    }
+# endif
+
+    /* ============================================================ */
+    /*                          Iterators                           */
+    /* ============================================================ */
+
+    iterator begin() {
+      return (iterator(_ptr));
+    }
+    const_iterator begin() const {
+      return (const_iterator(_ptr));
+    }
+
+    iterator end() {
+      return (iterator(_ptr + _size));
+    }
+    const_iterator end() const {
+      return (const_iterator(_ptr + _size));
+    }
+
+    reverse_iterator rbegin() {
+      return (reverse_iterator(end()));
+    }
+    const_reverse_iterator rbegin() const {
+      return (const_reverse_iterator(end()));
+    }
+
+    reverse_iterator rend() {
+      return (reverse_iterator(begin()));
+    }
+    const_reverse_iterator rend() const {
+      return (const_reverse_iterator(begin()));
+    }
+
+    /* ============================================================ */
+    /*                           Capacity                           */
+    /* ============================================================ */
+
+    size_type size() const {
+      return (_size);
+    }
+
+    size_type max_size() const {
+      return (_alloc.max_size());
+    }
+
+    /*
+    ** Change size
+    ** n이 현재 사이즈보다 작은 경우 이후 element를 제거하고, 큰 경우 val을 복사해서 크기가 n이 되도록 확장한다.
+    */
+    void resize(size_type n, value_type val = value_type()) {
+      if (n < _size) {
+        erase(begin() + n, end());
+      } else {
+        insert(end(), n - _size, val);
+      }
+    }
+
+    /*
+    ** Return size of allocated storage capacity
+    ** 객체 안의 저장 공간을 사용 중이라면 N을 반환한다.
+    */
+    size_type capacity() const {
+      return (_capacity);
+    }
+
+    bool empty() const {
+      return (_size == 0);
+    }
+
+    /*
+    ** Request a change in capacity
+    ** n이 현재 capacity보다 크면 힙에 스토리지를 재할당한다.
+    ** 요청한 크기가 max_size보다 크면 length_error를 throw 한다.
+    */
+    void reserve(size_type n) {
+      if (n > max_size()) {
+        throw (std::length_error("ft::small_vector::reserve"));
+      } else if (n > _capacity) {
+        relocate_around(_alloc.allocate(n), n, _size, 0);
+      }
+    }
+
+    /*
+    ** Shrink to fit
+    ** 힙 버퍼를 사용 중일 때 element가 N개 이하라면 객체 안의 저장 공간으로 되돌아오고,
+    ** 그보다 많다면 capacity를 size에 맞게 줄인다. 예외가 발생하면 벡터는 그대로 남는다.
+    */
+    void shrink_to_fit() {
+      if (is_inline() || _capacity == _size) return ;
+      if (_size <= N) {
+        ft::relocate(_alloc, _ptr, _ptr + _size, inline_data());
+        release_buffer();
+        _ptr = inline_data();
+        _capacity = N;
+      } else {
+        relocate_around(_alloc.allocate(_size), _size, _size, 0);
+      }
+    }
+
+    /* Test whether elements are stored inside the object */
+    bool is_inline() const {
+      return (_ptr == inline_data());
+    }
+
+    /* ============================================================ */
+    /*                        Element access                        */
+    /* ============================================================ */
+
+    reference operator[](size_type n) {
+      return (_ptr[n]);
+    }
+    const_reference operator[](size_type n) const {
+      return (_ptr[n]);
+    }
+
+    reference at(size_type n) {
+      if (n >= size())
+        throw (std::out_of_range("ft::small_vector::at"));
+      return (_ptr[n]);
+    }
+    const_reference at(size_type n) const {
+      if (n >= size())
+        throw (std::out_of_range("ft::small_vector::at"));
+      return (_ptr[n]);
+    }
+
+    reference front() {
+      return (*begin());
+    }
+    const_reference front() const {
+      return (*begin());
+    }
+
+    reference back() {
+      return (*(end() - 1));
+    }
+    const_reference back() const {
+      return (*(end() - 1));
+    }
+
+    /* ============================================================ */
+    /*                          Modifiers                           */
+    /* ============================================================ */
+
+    template <class InputIterator>
+    void assign(InputIterator first, InputIterator last,
+      typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL) {
+        clear();
+        insert(end(), first, last);
+      }
+    void assign(size_type n, const value_type& val) {
+      clear();
+      insert(end(), n, val);
+    }
+
+    void push_back(const value_type& val) {
+      if (_size == _capacity) {
+        realloc_insert(_size, 1, val);
+      } else {
+        _alloc.construct(_ptr + _size, val);
+        _size++;
+      }
+    }
+# if __cplusplus >= 201103L
+    void push_back(value_type&& val) {
+      emplace_back(std::move(val));
+    }
+
+    template <class... Args>
+    void emplace_back(Args&&... args) {
+      if (_size == _capacity) {
+        realloc_emplace(_size, std::forward<Args>(args)...);
+      } else {
+        std::allocator_traits<allocator_type>::construct(_alloc, _ptr + _size, std::forward<Args>(args)...);
+        _size++;
+      }
+    }
+# endif
+
+    void pop_back() {
+      if (_size > 0) {
+        _alloc.destroy(_ptr + (_size - 1));
+        _size--;
+      }
+    }
+
+    iterator insert(iterator position, const value_type& val) {
+      size_type idx = position - begin();
+      insert(position, 1, val);
+      return (begin() + idx);
+    }
+    void insert(iterator position, size_type n, const value_type& val) {
+      size_type idx = position - begin();
+      if (n == 0) return ;
+      if (n > _capacity - _size) {
+        realloc_insert(idx, n, val);
+      } else if (is_own_element(&val)) {
+        value_type tmp(val);
+        ft::buffer_insert_fill(_alloc, _ptr, _size, idx, n, tmp);
+      } else {
+        ft::buffer_insert_fill(_alloc, _ptr, _size, idx, n, val);
+      }
+    }
+    template <class InputIterator>
+    void insert(iterator position, InputIterator first, InputIterator last,
+      typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL) {
+        range_insert(position - begin(), first, last, ft::iterator_category(first));
+      }
+# if __cplusplus >= 201103L
+    iterator insert(iterator position, value_type&& val) {
+      return (emplace(position, std::move(val)));
+    }
+
+    template <class... Args>
+    iterator emplace(iterator position, Args&&... args) {
+      size_type idx = position - begin();
+      if (_size == _capacity) {
+        realloc_emplace(idx, std::forward<Args>(args)...);
+      } else {
+        ft::buffer_emplace(_alloc, _ptr, _size, idx, std::forward<Args>(args)...);
+      }
+      return (begin() + idx);
+    }
+# endif
+
+    iterator erase(iterator position) {
+      if (empty()) return (end());
+      return (erase(position, position + 1));
+    }
+    iterator erase(iterator first, iterator last) {
+      size_type idx = first - begin();
+      size_type n = last - first;
+      if (n > 0)
+        ft::buffer_erase(_alloc, _ptr, _size, idx, n);
+      return (begin() + idx);
+    }
+
+    template <class Predicate>
+    size_type erase_if(Predicate pred) {
+      return (ft::buffer_erase_if(_alloc, _ptr, _size, pred));
+    }
+
+    template <class InputIterator>
+    size_type erase_indices(InputIterator first, InputIterator last,
+      typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL) {
+        return (erase_indices_dispatch(first, last, ft::iterator_category(first)));
+      }
+
+    iterator erase_unordered(iterator position) {
+      ft::buffer_erase_unordered(_alloc, _ptr, _size, size_type(position - begin()));
+      return (position);
+    }
+
+    /*
+    ** Swap content
+    ** 둘 다 힙 버퍼를 사용 중이라면 포인터만 교환한다.
+    ** 한쪽만 힙 버퍼를 사용 중이고 allocator가 같다면 힙 버퍼는 넘겨주고, 객체 안의 element(N개 이하)만 상대의 저장 공간으로 옮긴다.
+    ** 둘 다 객체 안의 저장 공간을 사용 중이라면 앞쪽은 element끼리 교환하고 긴 쪽의 나머지만 옮긴다.
+    */
+    void swap(small_vector& x) {
+      if (is_inline() && x.is_inline()) {
+        swap_inline(x);
+        return ;
+      }
+      if (is_inline() || x.is_inline()) {
+        small_vector& local = is_inline() ? *this : x;
+        small_vector& heap = is_inline() ? x : *this;
+        if (local._alloc == heap._alloc) {
+          hand_over_heap(local, heap);
+        } else {
+          small_vector tmp(*this);
+          *this = x;
+          x = tmp;
+        }
+        return ;
+      }
+      allocator_type    tmp_alloc = _alloc;
+      pointer           tmp_ptr = _ptr;
+      size_type         tmp_capacity = _capacity;
+      size_type         tmp_size = _size;
+
+      _alloc = x._alloc;
+      _ptr = x._ptr;
+      _capacity = x._capacity;
+      _size = x._size;
+
+      x._alloc = tmp_alloc;
+      x._ptr = tmp_ptr;
+      x._capacity = tmp_capacity;
+      x._size = tmp_size;
+    }
+
+    /*
+    ** Clear content
+    ** 모든 element를 제거한다. 힙 버퍼는 해제하지 않고 유지한다.
+    */
+    void clear() {
+      ft::destroy(_alloc, _ptr, _ptr + _size);
+      _size = 0;
+    }
+
+    /* ============================================================ */
+    /*                          Allocator                           */
+    /* ============================================================ */
+
+    allocator_type get_allocator() const {
+      return (Alloc(_alloc));
+    }
+
+    private:
+    pointer inline_data() {
+      return (static_cast<pointer>(static_cast<void*>(&_buffer)));
+    }
+    const_pointer inline_data() const {
+      return (static_cast<const_pointer>(static_cast<const void*>(&_buffer)));
+    }
+
+    /* 힙 버퍼를 사용 중이라면 해제한다. element는 미리 파괴되었거나 옮겨진 상태여야 한다. */
+    void release_buffer() {
+      if (!is_inline())
+        _alloc.deallocate(_ptr, _capacity);
+    }
+
+    /*
+    ** heap의 힙 버퍼를 local에 넘기고, local의 element를 heap의 저장 공간으로 옮긴다.
+    ** 옮기다가 예외가 발생하면 두 벡터 모두 그대로 남는다.
+    */
+    static void hand_over_heap(small_vector& local, small_vector& heap) {
+      pointer   ptr = heap._ptr;
+      size_type capacity = heap._capacity;
+      size_type size = heap._size;
+      ft::relocate(local._alloc, local._ptr, local._ptr + local._size, heap.inline_data());
+      heap._ptr = heap.inline_data();
+      heap._capacity = N;
+      heap._size = local._size;
+      local._ptr = ptr;
+      local._capacity = capacity;
+      local._size = size;
+    }
+
+    /* 둘 다 객체 안의 저장 공간을 사용 중일 때 element를 교환한다. */
+    void swap_inline(small_vector& x) {
+      small_vector& longer = (_size < x._size) ? x : *this;
+      small_vector& shorter = (_size < x._size) ? *this : x;
+      size_type common = shorter._size;
+      for (size_type i = 0; i < common; i++)
+        std::swap(_ptr[i], x._ptr[i]);
+      ft::relocate(longer._alloc, longer._ptr + common, longer._ptr + longer._size, shorter._ptr + common);
+      shorter._size = longer._size;
+      longer._size = common;
+    }
+
+    /* 다음 재할당 때 사용할 capacity를 계산한다. ft::vector와 같이 두 배씩 늘린다. */
+    size_type next_capacity(size_type min_capacity) const {
+      size_type max = max_size();
+      if (min_capacity > max)
+        throw (std::length_error("ft::small_vector"));
+      if (_capacity >= max / 2)
+        return (max);
+      size_type n = (_capacity == 0) ? 1 : _capacity * 2;
+      return (n < min_capacity ? min_capacity : n);
+    }
+
+    /* Range insert helpers, ft::vector와 같다. */
+    template <class InputIterator>
+    void range_insert(size_type idx, InputIterator first, InputIterator last, ft::input_iterator_tag) {
+      if (idx == _size) {
+        for (; first != last; ++first)
+          push_back(*first);
+      } else {
+        small_vector tmp(first, last, _alloc);
+        range_insert(idx, tmp.begin(), tmp.end(), ft::random_access_iterator_tag());
+      }
+    }
+    template <class ForwardIterator>
+    void range_insert(size_type idx, ForwardIterator first, ForwardIterator last, ft::forward_iterator_tag) {
+      size_type n = ft::distance(first, last);
+      if (n == 0) return ;
+      if (n > _capacity - _size || is_own_range(first, n)) {
+        realloc_insert(idx, first, last, n);
+      } else {
+        ft::buffer_insert_range(_alloc, _ptr, _size, idx, first, last, n);
+      }
+    }
+
+    bool is_own_element(const void* p) const {
+      return (p >= static_cast<const void*>(_ptr) && p < static_cast<const void*>(_ptr + _size));
+    }
+
+    /* erase_indices helpers, ft::vector와 같다. 정렬할 index는 16개까지 객체 안에 담는다. */
+    template <class InputIterator>
+    size_type erase_indices_dispatch(InputIterator first, InputIterator last, ft::input_iterator_tag) {
+      small_vector<size_type, 16> indices(first, last);
+      return (erase_indices_dispatch(indices.begin(), indices.end(), ft::random_access_iterator_tag()));
+    }
+    template <class ForwardIterator>
+    size_type erase_indices_dispatch(ForwardIterator first, ForwardIterator last, ft::forward_iterator_tag) {
+      if (ft::is_sorted(first, last))
+        return (ft::buffer_erase_indices(_alloc, _ptr, _size, first, last));
+      small_vector<size_type, 16> indices(first, last);
+      small_vector<size_type, 16> buffer(indices);
+      ft::stable_sort(indices.begin(), indices.end(), buffer.begin(), std::less<size_type>());
+      return (ft::buffer_erase_indices(_alloc, _ptr, _size, indices.begin(), indices.end()));
+    }
+
+    /* ft::vector와 같이 value_type의 연속된 메모리를 가리키는 iterator만 주소를 비교한다. */
+    template <class ForwardIterator>
+    bool is_own_range(ForwardIterator first, size_type n) const {
+      typedef typename remove_cv<typename iterator_traits<ForwardIterator>::value_type>::type iter_value_type;
+      return (is_own_range(first, n, integral_constant<bool,
+        is_contiguous_iterator<ForwardIterator>::value && is_same<iter_value_type, value_type>::value>()));
+    }
+    template <class ContiguousIterator>
+    bool is_own_range(ContiguousIterator first, size_type n, true_type) const {
+      const value_type* p = ft::to_address(first);
+      return (is_own_element(p) || is_own_element(p + (n - 1)));
+    }
+    template <class ForwardIterator>
+    bool is_own_range(ForwardIterator, size_type, false_type) const {
+      return (false);
+    }
+
+    /*
+    ** 새 힙 버퍼 new_ptr로 기존 element를 옮기면서 [idx, idx + n) 자리는 비워두고, 기존 버퍼를 해제한다.
+    ** 호출하는 쪽은 그 자리에 새 element를 미리 생성해 두어야 한다.
+    */
+    void relocate_around(pointer new_ptr, size_type new_capacity, size_type idx, size_type n) {
+      try {
+        ft::relocate_with_gap(_alloc, _ptr, _ptr + idx, _ptr + _size, new_ptr, n);
+      } catch (...) {
+        ft::destroy(_alloc, new_ptr + idx, new_ptr + idx + n);
+        _alloc.deallocate(new_ptr, new_capacity);
+        throw ;
+      }
+      release_buffer();
+      _ptr = new_ptr;
+      _capacity = new_capacity;
+      _size += n;
+    }
+
+    /* 재할당하면서 idx 위치에 element를 삽입한다. ft::vector::realloc_insert와 같다. */
+    void realloc_insert(size_type idx, size_type n, const value_type& val) {
+      size_type new_capacity = (n > _capacity - _size) ? next_capacity(_size + n) : _capacity;
+      pointer new_ptr = _alloc.allocate(new_capacity);
+      try {
+        ft::uninitialized_fill_n(_alloc, new_ptr + idx, n, val);
+      } catch (...) {
+        _alloc.deallocate(new_ptr, new_capacity);
+        throw ;
+      }
+      relocate_around(new_ptr, new_capacity, idx, n);
+    }
+    template <class ForwardIterator>
+    void realloc_insert(size_type idx, ForwardIterator first, ForwardIterator last, size_type n) {
+      size_type new_capacity = (n > _capacity - _size) ? next_capacity(_size + n) : _capacity;
+      pointer new_ptr = _alloc.allocate(new_capacity);
+      try {
+        ft::uninitialized_copy(_alloc, first, last, new_ptr + idx);
+      } catch (...) {
+        _alloc.deallocate(new_ptr, new_capacity);
+        throw ;
+      }
+      relocate_around(new_ptr, new_capacity, idx, n);
+    }
+# if __cplusplus >= 201103L
+    template <class... Args>
+    void realloc_emplace(size_type idx, Args&&... args) {
+      size_type new_capacity = next_capacity(_size + 1);
+      pointer new_ptr = _alloc.allocate(new_capacity);
+      try {
+        std::allocator_traits<allocator_type>::construct(_alloc, new_ptr + idx, std::forward<Args>(args)...);
+      } catch (...) {
+        _alloc.deallocate(new_ptr, new_capacity);
+        throw ;
+      }
+      relocate_around(new_ptr, new_capacity, idx, 1);
+    }
+
+    /*
+    ** 비어 있는 이 벡터로 x의 element를 옮기고 x를 비운다.
+    ** x가 힙 버퍼를 사용 중이고 allocator가 같다면 버퍼를 넘겨받고, x는 객체 안의 저장 공간으로 돌아간다.
+    */
+    void take(small_vector& x) {
+      if (!x.is_inline() && _alloc == x._alloc) {
+        release_buffer();
+        _ptr = x._ptr;
+        _capacity = x._capacity;
+        _size = x._size;
+        x._ptr = x.inline_data();
+        x._capacity = N;
+        x._size = 0;
+      } else {
+        reserve(x._size);
+        for (size_type i = 0; i < x._size; i++)
+          emplace_back(std::move(x._ptr[i]));
+        x.clear();
+      }
+    }
+# endif
+  };
+
+  template <class T, std::size_t N, class Alloc>
+  const typename small_vector<T, N, Alloc>::size_type small_vector<T, N, Alloc>::inline_capacity;
+
+  /* ============================================================ */
+  /*                                                              */
+  /*                Non-member function overloads                 */
+  /*                                                              */
+  /* ============================================================ */
+
+  template <class T, std::size_t N, class Alloc>
+  bool operator==(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs) {
+    return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+  }
+  template <class T, std::size_t N, class Alloc>
+  bool operator!=(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs) {
+    return (!(lhs == rhs));
+  }
+  template <class T, std::size_t N, class Alloc>
+  bool operator< (const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs) {
+    return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+  }
+  template <class T, std::size_t N, class Alloc>
+  bool operator<=(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs) {
+    return (!(lhs > rhs));
+  }
+  template <class T, std::size_t N, class Alloc>
+  bool operator> (const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs) {
+    return (rhs < lhs);
+  }
+  template <class T, std::size_t N, class Alloc>
+  bool operator>=(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs) {
+    return (!(lhs < rhs));
+  }
+
+  template <class T, std::size_t N, class Alloc>
+  void swap(small_vector<T, N, Alloc>& x, small_vector<T, N, Alloc>& y) {
+    x.swap(y);
+  }
+}
+
+#endif
@@ -4,13 +4,54 @@
 /*
 ** equal
 ** lexicographical_compare
+** find, count
+** copy, copy_backward, fill
+** merge
+** stable_sort, is_sorted
 */
 
+# include <climits>   // CHAR_MIN
+# include <cstddef>   // std::size_t
+# include <cstring>   // std::memcmp
+# include "iterator.hpp"
+# include "simd.hpp"
+# include "type_traits.hpp"
+
 namespace ft {
 
-  /* equal */
+  /*
+  ** 값이 같으면 메모리 표현도 같아서 byte 단위로 비교할 수 있는 타입이다.
+  ** 부동소수점은 0.0과 -0.0, NaN 때문에 제외한다.
+  */
+  template <class T>
+  struct is_bytewise_comparable
+    : public integral_constant<bool, is_integral<T>::value || is_pointer<T>::value> {};
+
+  /* 두 iterator가 모두 연속된 메모리를 가리키고, 같은 byte 비교 가능 타입을 담고 있는지 식별한다. */
+  template <class Iterator1, class Iterator2>
+  struct is_bytewise_range_pair
+    : public integral_constant<bool,
+        is_contiguous_iterator<Iterator1>::value && is_contiguous_iterator<Iterator2>::value
+        && is_same<typename remove_cv<typename iterator_traits<Iterator1>::value_type>::type,
+                   typename remove_cv<typename iterator_traits<Iterator2>::value_type>::type>::value
+        && is_bytewise_comparable<typename remove_cv<typename iterator_traits<Iterator1>::value_type>::type>::value> {};
+
+  /* iterator가 연속된 메모리를 가리키고, element와 찾는 값이 같은 타입이며 SIMD 커널이 다룰 수 있는 크기인지 식별한다. */
+  template <class Iterator, class T>
+  struct is_bytewise_search
+    : public integral_constant<bool,
+        is_contiguous_iterator<Iterator>::value
+        && is_same<typename remove_cv<typename iterator_traits<Iterator>::value_type>::type,
+                   typename remove_cv<T>::type>::value
+        && is_bytewise_comparable<typename remove_cv<T>::type>::value
+        && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)> {};
+
+  /* ============================================================ */
+  /*                            equal                             */
+  /* ============================================================ */
+
   template <class InputIterator1, class InputIterator2>
-  bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2) {
+  bool equal_dispatch(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, false_type) {
     while (first1 != last1) {
       if (!(*first1 == *first2)) return (false);
       ++first1;
@@ -18,6 +59,20 @@ namespace ft {
     }
     return (true);
   }
+  template <class ContiguousIterator1, class ContiguousIterator2>
+  bool equal_dispatch(ContiguousIterator1 first1, ContiguousIterator1 last1, ContiguousIterator2 first2, true_type) {
+    std::size_t n = last1 - first1;
+    return (n == 0 || std::memcmp(ft::to_address(first1), ft::to_address(first2), n * sizeof(*ft::to_address(first1))) == 0);
+  }
+
+  /*
+  ** equal
+  ** 정수나 포인터가 연속으로 놓인 두 범위(포인터, ft::vector의 iterator)는 memcmp 한 번으로 비교한다.
+  */
+  template <class InputIterator1, class InputIterator2>
+  bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2) {
+    return (equal_dispatch(first1, last1, first2, typename is_bytewise_range_pair<InputIterator1, InputIterator2>::type()));
+  }
   template <class InputIterator1, class InputIterator2, class BinaryPredicate>
   bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, BinaryPredicate pred) {
     while (first1 != last1) {
@@ -28,10 +83,13 @@ namespace ft {
     return (true);
   }
 
-  /* lexicographical_compare */
+  /* ============================================================ */
+  /*                   lexicographical_compare                    */
+  /* ============================================================ */
+
   template <class InputIterator1, class InputIterator2>
-  bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
-    InputIterator2 first2, InputIterator2 last2) {
+  bool lexicographical_compare_dispatch(InputIterator1 first1, InputIterator1 last1,
+    InputIterator2 first2, InputIterator2 last2, false_type) {
       while (first1 != last1) {
         if (first2 == last2 || *first2 < *first1) return (false);
         else if (*first1 < *first2) return (true);
@@ -40,6 +98,39 @@ namespace ft {
       }
       return (first2 != last2);
     }
+  template <class ContiguousIterator1, class ContiguousIterator2>
+  bool lexicographical_compare_dispatch(ContiguousIterator1 first1, ContiguousIterator1 last1,
+    ContiguousIterator2 first2, ContiguousIterator2 last2, true_type) {
+      typedef typename remove_cv<typename iterator_traits<ContiguousIterator1>::value_type>::type value_type;
+      const bool unsigned_bytes = is_same<value_type, unsigned char>::value
+        || (is_same<value_type, char>::value && CHAR_MIN == 0);
+      std::size_t n1 = last1 - first1;
+      std::size_t n2 = last2 - first2;
+      std::size_t n = n1 < n2 ? n1 : n2;
+      const value_type* a = ft::to_address(first1);
+      const value_type* b = ft::to_address(first2);
+      if (unsigned_bytes) {
+        int cmp = (n == 0) ? 0 : std::memcmp(a, b, n);
+        return (cmp < 0 || (cmp == 0 && n1 < n2));
+      }
+      std::size_t idx = ft::simd_mismatch(reinterpret_cast<const unsigned char*>(a),
+        reinterpret_cast<const unsigned char*>(b), n * sizeof(value_type)) / sizeof(value_type);
+      if (idx < n)
+        return (a[idx] < b[idx]);
+      return (n1 < n2);
+    }
+
+  /*
+  ** lexicographical_compare
+  ** 정수나 포인터가 연속으로 놓인 두 범위는 처음으로 다른 byte를 SIMD로 찾은 뒤 그 element만 비교한다.
+  ** unsigned char(부호 없는 char 포함)는 byte 순서가 곧 값의 순서이므로 memcmp의 결과를 그대로 쓴다.
+  */
+  template <class InputIterator1, class InputIterator2>
+  bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
+    InputIterator2 first2, InputIterator2 last2) {
+      return (lexicographical_compare_dispatch(first1, last1, first2, last2,
+        typename is_bytewise_range_pair<InputIterator1, InputIterator2>::type()));
+    }
   template <class InputIterator1, class InputIterator2, class Compare>
   bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
     InputIterator2 first2, InputIterator2 last2, Compare comp) {
@@ -49,6 +140,216 @@ namespace ft {
       }
       return ((first1 == last1) && (first2 != last2));
     }
+
+  /* ============================================================ */
+  /*                         find, count                          */
+  /* ============================================================ */
+
+  template <class InputIterator, class T>
+  InputIterator find_dispatch(InputIterator first, InputIterator last, const T& val, false_type) {
+    for (; first != last; ++first) {
+      if (*first == val) return (first);
+    }
+    return (last);
+  }
+  template <class ContiguousIterator, class T>
+  ContiguousIterator find_dispatch(ContiguousIterator first, ContiguousIterator last, const T& val, true_type) {
+    return (first + ft::simd_find<sizeof(T)>(reinterpret_cast<const unsigned char*>(ft::to_address(first)),
+      last - first, reinterpret_cast<const unsigned char*>(&val)));
+  }
+
+  /*
+  ** find
+  ** [first, last)에서 val과 같은 첫 번째 element를 가리키는 iterator를 반환하고, 없으면 last를 반환한다.
+  ** 정수나 포인터가 연속으로 놓인 범위에서 같은 타입의 값을 찾을 때는 SIMD로 여러 element를 한 번에 비교한다.
+  */
+  template <class InputIterator, class T>
+  InputIterator find(InputIterator first, InputIterator last, const T& val) {
+    return (find_dispatch(first, last, val, typename is_bytewise_search<InputIterator, T>::type()));
+  }
+
+  template <class InputIterator, class T>
+  typename iterator_traits<InputIterator>::difference_type
+  count_dispatch(InputIterator first, InputIterator last, const T& val, false_type) {
+    typename iterator_traits<InputIterator>::difference_type n = 0;
+    for (; first != last; ++first) {
+      if (*first == val) n++;
+    }
+    return (n);
+  }
+  template <class ContiguousIterator, class T>
+  typename iterator_traits<ContiguousIterator>::difference_type
+  count_dispatch(ContiguousIterator first, ContiguousIterator last, const T& val, true_type) {
+    return (ft::simd_count<sizeof(T)>(reinterpret_cast<const unsigned char*>(ft::to_address(first)),
+      last - first, reinterpret_cast<const unsigned char*>(&val)));
+  }
+
+  /*
+  ** count
+  ** [first, last)에서 val과 같은 element의 수를 반환한다. find와 같은 경우에 SIMD를 사용한다.
+  */
+  template <class InputIterator, class T>
+  typename iterator_traits<InputIterator>::difference_type
+  count(InputIterator first, InputIterator last, const T& val) {
+    return (count_dispatch(first, last, val, typename is_bytewise_search<InputIterator, T>::type()));
+  }
+
+  /* ============================================================ */
+  /*                    copy, copy_backward, fill                 */
+  /* ============================================================ */
+
+  /*
+  ** 두 iterator가 모두 연속된 메모리를 가리키고, 같은 trivially copyable 타입을 담고 있어서
+  ** memmove로 복사할 수 있는지 식별한다.
+  */
+  template <class Iterator1, class Iterator2>
+  struct is_memmovable_range_pair
+    : public integral_constant<bool,
+        is_contiguous_iterator<Iterator1>::value && is_contiguous_iterator<Iterator2>::value
+        && is_same<typename remove_cv<typename iterator_traits<Iterator1>::value_type>::type,
+                   typename iterator_traits<Iterator2>::value_type>::value
+        && is_trivially_copyable<typename iterator_traits<Iterator2>::value_type>::value> {};
+
+  /* copy */
+  template <class InputIterator, class OutputIterator>
+  OutputIterator copy_dispatch(InputIterator first, InputIterator last, OutputIterator result, false_type) {
+    for (; first != last; ++first, ++result)
+      *result = *first;
+    return (result);
+  }
+  template <class ContiguousIterator1, class ContiguousIterator2>
+  ContiguousIterator2 copy_dispatch(ContiguousIterator1 first, ContiguousIterator1 last, ContiguousIterator2 result, true_type) {
+    std::size_t n = static_cast<std::size_t>(last - first);
+    if (n > 0)
+      std::memmove(ft::to_address(result), ft::to_address(first), n * sizeof(*ft::to_address(first)));
+    return (result + n);
+  }
+
+  template <class InputIterator, class OutputIterator>
+  OutputIterator copy(InputIterator first, InputIterator last, OutputIterator result) {
+    return (copy_dispatch(first, last, result, typename is_memmovable_range_pair<InputIterator, OutputIterator>::type()));
+  }
+
+  /* copy_backward */
+  template <class BidirectionalIterator1, class BidirectionalIterator2>
+  BidirectionalIterator2 copy_backward_dispatch(BidirectionalIterator1 first, BidirectionalIterator1 last,
+    BidirectionalIterator2 result, false_type) {
+      while (last != first)
+        *--result = *--last;
+      return (result);
+    }
+  template <class ContiguousIterator1, class ContiguousIterator2>
+  ContiguousIterator2 copy_backward_dispatch(ContiguousIterator1 first, ContiguousIterator1 last,
+    ContiguousIterator2 result, true_type) {
+      std::size_t n = static_cast<std::size_t>(last - first);
+      result = result - n;
+      if (n > 0)
+        std::memmove(ft::to_address(result), ft::to_address(first), n * sizeof(*ft::to_address(first)));
+      return (result);
+    }
+
+  template <class BidirectionalIterator1, class BidirectionalIterator2>
+  BidirectionalIterator2 copy_backward(BidirectionalIterator1 first, BidirectionalIterator1 last,
+    BidirectionalIterator2 result) {
+      return (copy_backward_dispatch(first, last, result,
+        typename is_memmovable_range_pair<BidirectionalIterator1, BidirectionalIterator2>::type()));
+    }
+
+  /* fill */
+  template <class ForwardIterator, class T>
+  void fill(ForwardIterator first, ForwardIterator last, const T& val) {
+    for (; first != last; ++first)
+      *first = val;
+  }
+
+  /* ============================================================ */
+  /*                            merge                             */
+  /* ============================================================ */
+
+  /* 정렬된 두 범위를 합친다. 같은 값은 첫 번째 범위의 것이 먼저 온다. */
+  template <class InputIterator1, class InputIterator2, class OutputIterator, class Compare>
+  OutputIterator merge(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2,
+    OutputIterator result, Compare comp) {
+      for (; first1 != last1 && first2 != last2; ++result) {
+        if (comp(*first2, *first1)) {
+          *result = *first2;
+          ++first2;
+        } else {
+          *result = *first1;
+          ++first1;
+        }
+      }
+      return (ft::copy(first2, last2, ft::copy(first1, last1, result)));
+    }
+
+  /* ============================================================ */
+  /*                          stable_sort                         */
+  /* ============================================================ */
+
+  /* 짧은 구간을 삽입 정렬한다. 같은 값은 순서를 유지한다. */
+  template <class RandomAccessIterator, class Compare>
+  void insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+    if (first == last)
+      return ;
+    for (RandomAccessIterator it = first + 1; it != last; ++it) {
+      if (!comp(*it, *(it - 1)))
+        continue ;
+      typename iterator_traits<RandomAccessIterator>::value_type tmp = *it;
+      RandomAccessIterator hole = it;
+      for (; hole != first && comp(tmp, *(hole - 1)); --hole)
+        *hole = *(hole - 1);
+      *hole = tmp;
+    }
+  }
+
+  /* src의 이웃한 width 길이 구간을 둘씩 합쳐 dest에 쓴다. 이미 순서대로인 두 구간은 복사만 한다. */
+  template <class RandomAccessIterator1, class RandomAccessIterator2, class Compare>
+  void merge_pass(RandomAccessIterator1 src, std::size_t n, std::size_t width, RandomAccessIterator2 dest, Compare comp) {
+    for (std::size_t lo = 0; lo < n; lo += width * 2) {
+      std::size_t mid = (n - lo > width) ? lo + width : n;
+      std::size_t hi = (n - mid > width) ? mid + width : n;
+      if (mid == hi || !comp(*(src + mid), *(src + (mid - 1))))
+        ft::copy(src + lo, src + hi, dest + lo);
+      else
+        ft::merge(src + lo, src + mid, src + mid, src + hi, dest + lo, comp);
+    }
+  }
+
+  /*
+  ** [first, last)를 정렬하고 같은 값은 범위에서 먼저 나온 것이 앞에 오게 한다.
+  ** buffer는 범위와 같은 수의 element를 담고 있어야 한다.
+  ** 16개씩 삽입 정렬한 뒤, 범위와 buffer를 번갈아 쓰는 bottom-up merge sort로 합친다.
+  */
+  template <class RandomAccessIterator1, class RandomAccessIterator2, class Compare>
+  void stable_sort(RandomAccessIterator1 first, RandomAccessIterator1 last, RandomAccessIterator2 buffer, Compare comp) {
+    const std::size_t run = 16;
+    std::size_t n = static_cast<std::size_t>(last - first);
+    for (std::size_t lo = 0; lo < n; lo += run)
+      ft::insertion_sort(first + lo, first + (n - lo > run ? lo + run : n), comp);
+    bool in_buffer = false;
+    for (std::size_t width = run; width < n; width *= 2) {
+      if (in_buffer)
+        ft::merge_pass(buffer, n, width, first, comp);
+      else
+        ft::merge_pass(first, n, width, buffer, comp);
+      in_buffer = !in_buffer;
+    }
+    if (in_buffer)
+      ft::copy(buffer, buffer + n, first);
+  }
+
+  /* [first, last)가 내림차순인 곳 없이 정렬되어 있는지 확인한다. */
+  template <class ForwardIterator>
+  bool is_sorted(ForwardIterator first, ForwardIterator last) {
+    if (first == last)
+      return (true);
+    ForwardIterator next = first;
+    for (++next; next != last; ++first, ++next) {
+      if (*next < *first)
+        return (false);
+    }
+    return (true);
+  }
 }
 
 #endif
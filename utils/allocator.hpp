@@ -0,0 +1,789 @@
+#ifndef ALLOCATOR_HPP_
+# define ALLOCATOR_HPP_
+
+/*
+** monotonic_buffer_resource, pool_resource, synchronized_pool_resource
+** resource_allocator
+** arena_allocator, pool_allocator, synchronized_pool_allocator
+** malloc_allocator, mmap_allocator
+*/
+
+# include <cstddef>   // std::size_t, std::ptrdiff_t
+# include <cstdlib>   // std::malloc, std::realloc, std::free
+# include <cstring>   // std::memcpy
+# include <limits>    // std::numeric_limits
+# include <new>       // ::operator new, std::bad_alloc
+# include <pthread.h> // pthread_mutex_t
+# include <sys/mman.h> // mmap, munmap, madvise
+# include <unistd.h>  // sysconf
+# if defined(__GLIBC__)
+#  include <malloc.h>         // malloc_usable_size
+# elif defined(__APPLE__)
+#  include <malloc/malloc.h>  // malloc_size
+# endif
+# include "type_traits.hpp"
+# if __cplusplus >= 201103L
+#  include <utility>  // std::forward
+# endif
+
+namespace ft {
+
+  /* ============================================================ */
+  /*                                                              */
+  /*                       Memory resources                       */
+  /*                                                              */
+  /* ============================================================ */
+
+  /*
+  ** 메모리 resource는 allocate(bytes, alignment), deallocate(p, bytes, alignment)를 제공하고,
+  ** resource가 해제될 때 resource에서 할당한 메모리는 모두 함께 해제된다.
+  ** resource는 복사할 수 없고, resource를 사용하는 컨테이너보다 오래 살아있어야 한다.
+  */
+
+  /*
+  ** monotonic_buffer_resource
+  ** 큰 chunk를 할당해 두고 포인터를 앞으로 밀면서 나눠주는 arena이다.
+  ** deallocate는 아무 일도 하지 않고, release를 호출하거나 resource가 해제될 때 chunk를 한꺼번에 돌려준다.
+  ** chunk 크기는 할당할 때마다 두 배씩 늘어난다.
+  */
+  class monotonic_buffer_resource {
+    private:
+    struct chunk_header {
+      chunk_header*   next;
+      std::size_t     size;
+    };
+
+    chunk_header*   _chunks;
+    char*           _cur;
+    std::size_t     _left;
+    std::size_t     _initial_size;
+    std::size_t     _next_size;
+
+    monotonic_buffer_resource(const monotonic_buffer_resource&);
+    monotonic_buffer_resource& operator=(const monotonic_buffer_resource&);
+
+    public:
+    explicit monotonic_buffer_resource(std::size_t initial_size = 1024)
+      : _chunks(NULL), _cur(NULL), _left(0),
+        _initial_size(initial_size > 0 ? initial_size : 1), _next_size(_initial_size) {}
+    ~monotonic_buffer_resource() {
+      release();
+    }
+
+    void* allocate(std::size_t bytes, std::size_t alignment) {
+      std::size_t padding = (alignment - reinterpret_cast<std::size_t>(_cur) % alignment) % alignment;
+      if (_cur == NULL || padding + bytes > _left) {
+        new_chunk(bytes + alignment);
+        padding = (alignment - reinterpret_cast<std::size_t>(_cur) % alignment) % alignment;
+      }
+      void* p = _cur + padding;
+      _cur += padding + bytes;
+      _left -= padding + bytes;
+      return (p);
+    }
+    void deallocate(void*, std::size_t, std::size_t) {}
+
+    /* 할당한 chunk를 모두 해제하고 처음 상태로 돌아간다. O(chunk 수)이다. */
+    void release() {
+      while (_chunks != NULL) {
+        chunk_header* next = _chunks->next;
+        ::operator delete(static_cast<void*>(_chunks));
+        _chunks = next;
+      }
+      _cur = NULL;
+      _left = 0;
+      _next_size = _initial_size;
+    }
+
+    private:
+    void new_chunk(std::size_t min_size) {
+      std::size_t size = _next_size;
+      while (size < min_size)
+        size *= 2;
+      chunk_header* chunk = static_cast<chunk_header*>(::operator new(sizeof(chunk_header) + size));
+      chunk->next = _chunks;
+      chunk->size = size;
+      _chunks = chunk;
+      _cur = reinterpret_cast<char*>(chunk + 1);
+      _left = size;
+      _next_size = size * 2;
+    }
+  };
+
+  /*
+  ** pool_resource
+  ** 16바이트 단위의 block 크기별로 free list를 두고, 같은 크기의 block을 재사용하는 pool이다.
+  ** 빈 free list는 block 여러 개를 담은 chunk를 할당해 채우고, 해제된 block은 free list로 돌아간다.
+  ** max_block_size보다 크거나 정렬이 block_alignment보다 큰 요청은 operator new로 바로 할당한다.
+  */
+  class pool_resource {
+    public:
+    static const std::size_t  block_alignment = 16;
+    static const std::size_t  max_block_size = 512;
+
+    private:
+    static const std::size_t  pool_count = max_block_size / block_alignment;
+
+    struct free_block {
+      free_block*   next;
+    };
+    struct chunk_header {
+      chunk_header*   next;
+      char            _pad[block_alignment - sizeof(chunk_header*)];
+    };
+
+    free_block*     _free[pool_count];
+    std::size_t     _blocks_per_chunk[pool_count];
+    chunk_header*   _chunks;
+
+    pool_resource(const pool_resource&);
+    pool_resource& operator=(const pool_resource&);
+
+    public:
+    pool_resource() : _chunks(NULL) {
+      for (std::size_t i = 0; i < pool_count; i++) {
+        _free[i] = NULL;
+        _blocks_per_chunk[i] = 8;
+      }
+    }
+    ~pool_resource() {
+      release();
+    }
+
+    void* allocate(std::size_t bytes, std::size_t alignment) {
+      if (bytes > max_block_size || alignment > block_alignment)
+        return (::operator new(bytes));
+      std::size_t idx = pool_index(bytes);
+      if (_free[idx] == NULL)
+        refill(idx);
+      free_block* block = _free[idx];
+      _free[idx] = block->next;
+      return (block);
+    }
+    void deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+      if (bytes > max_block_size || alignment > block_alignment) {
+        ::operator delete(p);
+        return ;
+      }
+      std::size_t idx = pool_index(bytes);
+      free_block* block = static_cast<free_block*>(p);
+      block->next = _free[idx];
+      _free[idx] = block;
+    }
+
+    /* pool이 할당한 chunk를 모두 해제한다. operator new로 바로 할당한 큰 block은 해제하지 않는다. */
+    void release() {
+      while (_chunks != NULL) {
+        chunk_header* next = _chunks->next;
+        ::operator delete(static_cast<void*>(_chunks));
+        _chunks = next;
+      }
+      for (std::size_t i = 0; i < pool_count; i++) {
+        _free[i] = NULL;
+        _blocks_per_chunk[i] = 8;
+      }
+    }
+
+    private:
+    static std::size_t pool_index(std::size_t bytes) {
+      return (bytes == 0 ? 0 : (bytes - 1) / block_alignment);
+    }
+
+    /* block을 담은 chunk를 하나 할당해 free list에 넣는다. chunk의 block 수는 1024개까지 두 배씩 늘어난다. */
+    void refill(std::size_t idx) {
+      std::size_t block_size = (idx + 1) * block_alignment;
+      std::size_t count = _blocks_per_chunk[idx];
+      chunk_header* chunk = static_cast<chunk_header*>(::operator new(sizeof(chunk_header) + block_size * count));
+      chunk->next = _chunks;
+      _chunks = chunk;
+      char* first = reinterpret_cast<char*>(chunk + 1);
+      for (std::size_t i = count; i > 0; i--) {
+        free_block* block = reinterpret_cast<free_block*>(first + (i - 1) * block_size);
+        block->next = _free[idx];
+        _free[idx] = block;
+      }
+      if (count < 1024)
+        _blocks_per_chunk[idx] = count * 2;
+    }
+  };
+
+  /*
+  ** synchronized_pool_resource
+  ** pool_resource의 모든 연산을 mutex로 감싸서 여러 thread가 하나의 pool을 공유할 수 있게 한다.
+  */
+  class synchronized_pool_resource {
+    private:
+    pool_resource     _pool;
+    pthread_mutex_t   _mutex;
+
+    /* 생성자에서 lock을 걸고 소멸자에서 푼다. 예외가 발생해도 lock이 풀린다. */
+    class lock_guard {
+      private:
+      pthread_mutex_t&  _m;
+      lock_guard(const lock_guard&);
+      lock_guard& operator=(const lock_guard&);
+
+      public:
+      explicit lock_guard(pthread_mutex_t& m) : _m(m) {
+        pthread_mutex_lock(&_m);
+      }
+      ~lock_guard() {
+        pthread_mutex_unlock(&_m);
+      }
+    };
+
+    synchronized_pool_resource(const synchronized_pool_resource&);
+    synchronized_pool_resource& operator=(const synchronized_pool_resource&);
+
+    public:
+    synchronized_pool_resource() : _pool() {
+      pthread_mutex_init(&_mutex, NULL);
+    }
+    ~synchronized_pool_resource() {
+      pthread_mutex_destroy(&_mutex);
+    }
+
+    void* allocate(std::size_t bytes, std::size_t alignment) {
+      lock_guard lock(_mutex);
+      return (_pool.allocate(bytes, alignment));
+    }
+    void deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+      lock_guard lock(_mutex);
+      _pool.deallocate(p, bytes, alignment);
+    }
+    void release() {
+      lock_guard lock(_mutex);
+      _pool.release();
+    }
+  };
+
+  /* ============================================================ */
+  /*                                                              */
+  /*                          Allocators                          */
+  /*                                                              */
+  /* ============================================================ */
+
+  /*
+  ** resource_allocator
+  ** Resource에 할당을 맡기는 allocator이다. 포인터만 들고 있으므로 복사와 rebind가 자유롭고,
+  ** 같은 resource를 가리키는 allocator끼리는 같다고 비교되어 서로의 메모리를 해제할 수 있다.
+  ** resource 없이 기본 생성된 allocator는 operator new와 operator delete를 사용한다.
+  */
+  template <class T, class Resource>
+  class resource_allocator {
+    public:
+    typedef T                 value_type;
+    typedef T*                pointer;
+    typedef const T*          const_pointer;
+    typedef T&                reference;
+    typedef const T&          const_reference;
+    typedef std::size_t       size_type;
+    typedef std::ptrdiff_t    difference_type;
+    typedef Resource          resource_type;
+
+    template <class U>
+    struct rebind {
+      typedef resource_allocator<U, Resource> other;
+    };
+
+    private:
+    resource_type*    _resource;
+
+    public:
+    resource_allocator() : _resource(NULL) {}
+    explicit resource_allocator(resource_type* resource) : _resource(resource) {}
+    resource_allocator(const resource_allocator& other) : _resource(other._resource) {}
+    template <class U>
+    resource_allocator(const resource_allocator<U, Resource>& other) : _resource(other.resource()) {}
+    ~resource_allocator() {}
+
+    resource_allocator& operator=(const resource_allocator& other) {
+      _resource = other._resource;
+      return (*this);
+    }
+
+    resource_type* resource() const {
+      return (_resource);
+    }
+
+    pointer address(reference x) const {
+      return (&x);
+    }
+    const_pointer address(const_reference x) const {
+      return (&x);
+    }
+
+    pointer allocate(size_type n, const void* = 0) {
+      if (n > max_size())
+        throw (std::bad_alloc());
+      if (_resource == NULL)
+        return (static_cast<pointer>(::operator new(n * sizeof(T))));
+      return (static_cast<pointer>(_resource->allocate(n * sizeof(T), alignment_of<T>::value)));
+    }
+    void deallocate(pointer p, size_type n) {
+      if (_resource == NULL)
+        ::operator delete(static_cast<void*>(p));
+      else
+        _resource->deallocate(static_cast<void*>(p), n * sizeof(T), alignment_of<T>::value);
+    }
+
+    size_type max_size() const {
+      return (std::numeric_limits<size_type>::max() / (sizeof(T) > 0 ? sizeof(T) : 1));
+    }
+
+# if __cplusplus >= 201103L
+    template <class U, class... Args>
+    void construct(U* p, Args&&... args) {
+      ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+# else
+    void construct(pointer p, const_reference val) {
+      ::new (static_cast<void*>(p)) T(val);
+    }
+# endif
+    void destroy(pointer p) {
+      p->~T();
+    }
+  };
+
+  template <class T, class U, class Resource>
+  bool operator==(const resource_allocator<T, Resource>& lhs, const resource_allocator<U, Resource>& rhs) {
+    return (lhs.resource() == rhs.resource());
+  }
+  template <class T, class U, class Resource>
+  bool operator!=(const resource_allocator<T, Resource>& lhs, const resource_allocator<U, Resource>& rhs) {
+    return (!(lhs == rhs));
+  }
+
+  /*
+  ** arena_allocator
+  ** monotonic_buffer_resource를 사용한다. 해제가 아무 일도 하지 않으므로, 요청 하나를 처리하는 동안 쓰는
+  ** 임시 컨테이너를 arena에 만들고 요청이 끝나면 release 한 번으로 한꺼번에 돌려주는 용도이다.
+  ** release 전에 컨테이너가 먼저 파괴되어야 한다.
+  */
+  template <class T>
+  class arena_allocator : public resource_allocator<T, monotonic_buffer_resource> {
+    public:
+    template <class U>
+    struct rebind {
+      typedef arena_allocator<U> other;
+    };
+
+    arena_allocator() {}
+    explicit arena_allocator(monotonic_buffer_resource* resource)
+      : resource_allocator<T, monotonic_buffer_resource>(resource) {}
+    template <class U>
+    arena_allocator(const arena_allocator<U>& other)
+      : resource_allocator<T, monotonic_buffer_resource>(other.resource()) {}
+  };
+
+  /*
+  ** pool_allocator
+  ** pool_resource를 사용한다. map의 node처럼 같은 크기로 할당과 해제를 반복하는 경우에 알맞다.
+  */
+  template <class T>
+  class pool_allocator : public resource_allocator<T, pool_resource> {
+    public:
+    template <class U>
+    struct rebind {
+      typedef pool_allocator<U> other;
+    };
+
+    pool_allocator() {}
+    explicit pool_allocator(pool_resource* resource)
+      : resource_allocator<T, pool_resource>(resource) {}
+    template <class U>
+    pool_allocator(const pool_allocator<U>& other)
+      : resource_allocator<T, pool_resource>(other.resource()) {}
+  };
+
+  /*
+  ** synchronized_pool_allocator
+  ** synchronized_pool_resource를 사용한다. 여러 thread의 컨테이너가 하나의 pool을 공유할 수 있다.
+  ** 컨테이너 자체는 thread-safe하지 않다.
+  */
+  template <class T>
+  class synchronized_pool_allocator : public resource_allocator<T, synchronized_pool_resource> {
+    public:
+    template <class U>
+    struct rebind {
+      typedef synchronized_pool_allocator<U> other;
+    };
+
+    synchronized_pool_allocator() {}
+    explicit synchronized_pool_allocator(synchronized_pool_resource* resource)
+      : resource_allocator<T, synchronized_pool_resource>(resource) {}
+    template <class U>
+    synchronized_pool_allocator(const synchronized_pool_allocator<U>& other)
+      : resource_allocator<T, synchronized_pool_resource>(other.resource()) {}
+  };
+
+  /* ============================================================ */
+  /*                                                              */
+  /*                       malloc_allocator                       */
+  /*                                                              */
+  /* ============================================================ */
+
+  /*
+  ** Reallocation protocol
+  ** allocator는 아래 두 멤버 함수를 선택적으로 제공할 수 있고, ft::vector는 있으면 사용한다.
+  ** - pointer reallocate(pointer p, size_type old_n, size_type new_n)
+  **     p의 block을 new_n개 크기로 늘리거나 줄인다. 가능하면 제자리에서 바꾸고, 옮겨야 하면 내용을 byte 단위로
+  **     복사한 새 block을 반환한다. 실패하면 bad_alloc을 throw 하고 p는 그대로 남는다.
+  **     byte 복사로 옮기므로 trivially relocatable한 element에만 사용한다.
+  ** - size_type usable_size(pointer p, size_type n) const
+  **     n개로 할당한 block p에 실제로 담을 수 있는 element의 수(n 이상)를 반환한다.
+  **     allocator는 이후 deallocate와 reallocate에서 n 대신 이 값을 받아도 같은 block으로 처리해야 한다.
+  */
+
+  /* malloc이 block에 실제로 잡아준 크기를 반환한다. 알 수 없는 환경에서는 bytes를 그대로 반환한다. */
+  inline std::size_t heap_usable_size(void* p, std::size_t bytes) {
+# if defined(__GLIBC__)
+    std::size_t usable = malloc_usable_size(p);
+# elif defined(__APPLE__)
+    std::size_t usable = malloc_size(p);
+# else
+    std::size_t usable = 0;
+    (void)p;
+# endif
+    return (usable > bytes ? usable : bytes);
+  }
+
+  /*
+  ** malloc_allocator
+  ** malloc과 free로 할당하고, reallocate는 realloc으로 block을 제자리에서 늘린다.
+  ** usable_size는 malloc이 size class를 맞추느라 더 잡아준 공간까지 capacity로 알려준다.
+  */
+  template <class T>
+  class malloc_allocator {
+    public:
+    typedef T                 value_type;
+    typedef T*                pointer;
+    typedef const T*          const_pointer;
+    typedef T&                reference;
+    typedef const T&          const_reference;
+    typedef std::size_t       size_type;
+    typedef std::ptrdiff_t    difference_type;
+
+    template <class U>
+    struct rebind {
+      typedef malloc_allocator<U> other;
+    };
+
+    malloc_allocator() {}
+    malloc_allocator(const malloc_allocator&) {}
+    template <class U>
+    malloc_allocator(const malloc_allocator<U>&) {}
+    ~malloc_allocator() {}
+
+    malloc_allocator& operator=(const malloc_allocator&) {
+      return (*this);
+    }
+
+    pointer address(reference x) const {
+      return (&x);
+    }
+    const_pointer address(const_reference x) const {
+      return (&x);
+    }
+
+    pointer allocate(size_type n, const void* = 0) {
+      if (n > max_size())
+        throw (std::bad_alloc());
+      void* p = std::malloc(n > 0 ? n * sizeof(T) : 1);
+      if (p == NULL)
+        throw (std::bad_alloc());
+      return (static_cast<pointer>(p));
+    }
+    void deallocate(pointer p, size_type) {
+      std::free(static_cast<void*>(p));
+    }
+    pointer reallocate(pointer p, size_type, size_type new_n) {
+      if (new_n > max_size())
+        throw (std::bad_alloc());
+      void* q = std::realloc(static_cast<void*>(p), new_n > 0 ? new_n * sizeof(T) : 1);
+      if (q == NULL)
+        throw (std::bad_alloc());
+      return (static_cast<pointer>(q));
+    }
+    size_type usable_size(pointer p, size_type n) const {
+      size_type usable = heap_usable_size(static_cast<void*>(p), n * sizeof(T)) / sizeof(T);
+      return (usable > n ? usable : n);
+    }
+
+    size_type max_size() const {
+      return (std::numeric_limits<size_type>::max() / (sizeof(T) > 0 ? sizeof(T) : 1));
+    }
+
+# if __cplusplus >= 201103L
+    template <class U, class... Args>
+    void construct(U* p, Args&&... args) {
+      ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+# else
+    void construct(pointer p, const_reference val) {
+      ::new (static_cast<void*>(p)) T(val);
+    }
+# endif
+    void destroy(pointer p) {
+      p->~T();
+    }
+  };
+
+  template <class T, class U>
+  bool operator==(const malloc_allocator<T>&, const malloc_allocator<U>&) {
+    return (true);
+  }
+  template <class T, class U>
+  bool operator!=(const malloc_allocator<T>&, const malloc_allocator<U>&) {
+    return (false);
+  }
+
+  /* ============================================================ */
+  /*                                                              */
+  /*                        mmap_allocator                        */
+  /*                                                              */
+  /* ============================================================ */
+
+  /*
+  ** mmap_allocator_base
+  ** threshold 이상의 할당은 anonymous mmap으로 직접 매핑하고, 그보다 작은 할당은 malloc을 사용한다.
+  ** reallocate는 매핑된 block을 mremap으로, 힙 block을 realloc으로 늘리므로 큰 벡터가 자랄 때 복사가 일어나지 않는다.
+  ** flags로 huge page와 pre-fault를 선택한다.
+  ** - mmap_hugetlb : MAP_HUGETLB로 예약된 huge page를 매핑한다. 예약된 page가 없으면 일반 매핑과 madvise로 대신한다.
+  ** - mmap_transparent_huge : huge page 경계에 맞춰 매핑하고 madvise(MADV_HUGEPAGE)로 transparent huge page를 요청한다.
+  ** - mmap_populate : MAP_POPULATE로 매핑할 때 page를 미리 채워서, 버퍼를 처음 쓸 때의 page fault를 없앤다.
+  ** huge page 옵션을 쓰면 매핑 크기를 huge_page_size 단위로 올림하므로, 해제할 때도 같은 flags가 필요하다.
+  ** Linux가 아닌 환경에서는 지원하지 않는 옵션을 무시한다.
+  */
+  class mmap_allocator_base {
+    public:
+    static const int          mmap_hugetlb = 1;
+    static const int          mmap_transparent_huge = 2;
+    static const int          mmap_populate = 4;
+    static const std::size_t  huge_page_size = 2 * 1024 * 1024;
+    static const std::size_t  default_threshold = 2 * 1024 * 1024;
+
+    protected:
+    std::size_t   _threshold;
+    int           _flags;
+
+    explicit mmap_allocator_base(std::size_t threshold, int flags)
+      : _threshold(threshold), _flags(flags) {}
+
+    public:
+    std::size_t threshold() const {
+      return (_threshold);
+    }
+    int flags() const {
+      return (_flags);
+    }
+
+    protected:
+    void* allocate_bytes(std::size_t bytes) const {
+      if (bytes < _threshold) {
+        void* p = std::malloc(bytes > 0 ? bytes : 1);
+        if (p == NULL)
+          throw (std::bad_alloc());
+        return (p);
+      }
+      std::size_t len = mapping_size(bytes);
+      void* p = MAP_FAILED;
+# ifdef MAP_HUGETLB
+      if (_flags & mmap_hugetlb)
+        p = map(len, MAP_HUGETLB);
+# endif
+      if (p == MAP_FAILED)
+        p = (_flags & (mmap_hugetlb | mmap_transparent_huge)) ? map_huge_aligned(len) : map(len, 0);
+      if (p == MAP_FAILED)
+        throw (std::bad_alloc());
+      return (p);
+    }
+    void deallocate_bytes(void* p, std::size_t bytes) const {
+      if (bytes < _threshold)
+        std::free(p);
+      else
+        munmap(p, mapping_size(bytes));
+    }
+
+    /*
+    ** 힙 block끼리는 realloc으로, 매핑끼리는 mremap으로 크기를 바꾼다.
+    ** 힙과 매핑 사이를 오가거나, mremap이 없거나 실패하면 새로 할당해서 복사한다.
+    ** 새 할당까지 실패해야 bad_alloc을 throw 하고, 그때 p는 그대로 남는다.
+    */
+    void* reallocate_bytes(void* p, std::size_t old_bytes, std::size_t new_bytes) const {
+      bool old_mapped = old_bytes >= _threshold;
+      bool new_mapped = new_bytes >= _threshold;
+      if (!old_mapped && !new_mapped) {
+        void* q = std::realloc(p, new_bytes > 0 ? new_bytes : 1);
+        if (q == NULL)
+          throw (std::bad_alloc());
+        return (q);
+      }
+# ifdef MREMAP_MAYMOVE
+      if (old_mapped && new_mapped) {
+        std::size_t old_len = mapping_size(old_bytes);
+        std::size_t new_len = mapping_size(new_bytes);
+        if (old_len == new_len)
+          return (p);
+        void* q = mremap(p, old_len, new_len, MREMAP_MAYMOVE);
+        if (q != MAP_FAILED) {
+#  ifdef MADV_HUGEPAGE
+          if (_flags & (mmap_hugetlb | mmap_transparent_huge))
+            madvise(q, new_len, MADV_HUGEPAGE);
+#  endif
+          return (q);
+        }
+      }
+# endif
+      void* q = allocate_bytes(new_bytes);
+      std::memcpy(q, p, old_bytes < new_bytes ? old_bytes : new_bytes);
+      deallocate_bytes(p, old_bytes);
+      return (q);
+    }
+
+    /*
+    ** bytes로 할당한 block p에 실제로 쓸 수 있는 byte 수를 elem_size 단위로 내림해서 반환한다.
+    ** 늘어난 크기로 해제해도 같은 block으로 처리되도록, 힙 block은 threshold를 넘지 않게 하고
+    ** 매핑은 올림한 매핑 크기가 바뀌지 않을 때만 늘린다.
+    */
+    std::size_t usable_bytes(void* p, std::size_t bytes, std::size_t elem_size) const {
+      std::size_t usable;
+      if (bytes < _threshold) {
+        usable = heap_usable_size(p, bytes);
+        if (usable >= _threshold)
+          usable = _threshold - 1;
+        usable = usable / elem_size * elem_size;
+      } else {
+        usable = mapping_size(bytes) / elem_size * elem_size;
+        if (mapping_size(usable) != mapping_size(bytes))
+          usable = bytes;
+      }
+      return (usable > bytes ? usable : bytes);
+    }
+
+    private:
+    std::size_t mapping_size(std::size_t bytes) const {
+      std::size_t unit = (_flags & (mmap_hugetlb | mmap_transparent_huge))
+        ? huge_page_size : static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+      return ((bytes + unit - 1) / unit * unit);
+    }
+
+    void* map(std::size_t len, int extra_flags) const {
+      int flags = MAP_PRIVATE | MAP_ANONYMOUS | extra_flags;
+# ifdef MAP_POPULATE
+      if (_flags & mmap_populate)
+        flags |= MAP_POPULATE;
+# endif
+      return (mmap(NULL, len, PROT_READ | PROT_WRITE, flags, -1, 0));
+    }
+
+    /*
+    ** huge page 하나만큼 더 크게 매핑한 뒤 앞뒤를 잘라내서 시작 주소를 huge page 경계에 맞춘다.
+    ** 경계에 맞아야 커널이 매핑 전체를 huge page로 채울 수 있다.
+    */
+    void* map_huge_aligned(std::size_t len) const {
+      char* raw = static_cast<char*>(map(len + huge_page_size, 0));
+      if (raw == MAP_FAILED)
+        return (MAP_FAILED);
+      std::size_t head = (huge_page_size - reinterpret_cast<std::size_t>(raw) % huge_page_size) % huge_page_size;
+      if (head > 0)
+        munmap(raw, head);
+      munmap(raw + head + len, huge_page_size - head);
+# ifdef MADV_HUGEPAGE
+      madvise(raw + head, len, MADV_HUGEPAGE);
+# endif
+      return (raw + head);
+    }
+  };
+
+  /*
+  ** mmap_allocator
+  ** 수 GB 단위의 큰 벡터 버퍼를 힙 대신 mmap으로 직접 매핑하는 allocator이다.
+  ** threshold와 flags가 같은 allocator끼리 같다고 비교되며, rebind해도 threshold와 flags를 유지한다.
+  */
+  template <class T>
+  class mmap_allocator : public mmap_allocator_base {
+    public:
+    typedef T                 value_type;
+    typedef T*                pointer;
+    typedef const T*          const_pointer;
+    typedef T&                reference;
+    typedef const T&          const_reference;
+    typedef std::size_t       size_type;
+    typedef std::ptrdiff_t    difference_type;
+
+    template <class U>
+    struct rebind {
+      typedef mmap_allocator<U> other;
+    };
+
+    explicit mmap_allocator(std::size_t threshold = default_threshold, int flags = 0)
+      : mmap_allocator_base(threshold, flags) {}
+    mmap_allocator(const mmap_allocator& other)
+      : mmap_allocator_base(other._threshold, other._flags) {}
+    template <class U>
+    mmap_allocator(const mmap_allocator<U>& other)
+      : mmap_allocator_base(other.threshold(), other.flags()) {}
+    ~mmap_allocator() {}
+
+    mmap_allocator& operator=(const mmap_allocator& other) {
+      _threshold = other._threshold;
+      _flags = other._flags;
+      return (*this);
+    }
+
+    pointer address(reference x) const {
+      return (&x);
+    }
+    const_pointer address(const_reference x) const {
+      return (&x);
+    }
+
+    pointer allocate(size_type n, const void* = 0) {
+      if (n > max_size())
+        throw (std::bad_alloc());
+      return (static_cast<pointer>(allocate_bytes(n * sizeof(T))));
+    }
+    void deallocate(pointer p, size_type n) {
+      deallocate_bytes(static_cast<void*>(p), n * sizeof(T));
+    }
+    pointer reallocate(pointer p, size_type old_n, size_type new_n) {
+      if (new_n > max_size())
+        throw (std::bad_alloc());
+      return (static_cast<pointer>(reallocate_bytes(static_cast<void*>(p), old_n * sizeof(T), new_n * sizeof(T))));
+    }
+    size_type usable_size(pointer p, size_type n) const {
+      return (usable_bytes(static_cast<void*>(p), n * sizeof(T), sizeof(T)) / sizeof(T));
+    }
+
+    size_type max_size() const {
+      return (std::numeric_limits<size_type>::max() / (sizeof(T) > 0 ? sizeof(T) : 1));
+    }
+
+# if __cplusplus >= 201103L
+    template <class U, class... Args>
+    void construct(U* p, Args&&... args) {
+      ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+# else
+    void construct(pointer p, const_reference val) {
+      ::new (static_cast<void*>(p)) T(val);
+    }
+# endif
+    void destroy(pointer p) {
+      p->~T();
+    }
+  };
+
+  template <class T, class U>
+  bool operator==(const mmap_allocator<T>& lhs, const mmap_allocator<U>& rhs) {
+    return (lhs.threshold() == rhs.threshold() && lhs.flags() == rhs.flags());
+  }
+  template <class T, class U>
+  bool operator!=(const mmap_allocator<T>& lhs, const mmap_allocator<U>& rhs) {
+    return (!(lhs == rhs));
+  }
+}
+
+#endif
@@ -0,0 +1,1041 @@
+#ifndef BTREE_HPP_
+# define BTREE_HPP_
+
+/*
+** select_first, identity
+** btree_slot (inline, indirect)
+** btree_node_base, btree_leaf_base, btree_leaf, btree_internal
+** btree_iterator
+** B+ tree
+*/
+
+# include <algorithm>   // std::swap
+# include <cstddef>     // std::size_t
+# include <cstring>     // std::memcpy, std::memmove
+# include <functional>  // std::less
+# include "iterator.hpp"
+# include "memory.hpp"
+# include "simd.hpp"
+# include "type_traits.hpp"
+# include "utility.hpp"
+
+namespace ft {
+
+  /* ============================================================ */
+  /*                        key extraction                        */
+  /* ============================================================ */
+
+  /* pair에서 key(first)를 꺼낸다. btree_map이 사용한다. */
+  template <class Pair>
+  struct select_first {
+    const typename Pair::first_type& operator()(const Pair& x) const {
+      return (x.first);
+    }
+  };
+
+  /* value 자체가 key이다. btree_set이 사용한다. */
+  template <class T>
+  struct identity {
+    const T& operator()(const T& x) const {
+      return (x);
+    }
+  };
+
+  /* ============================================================ */
+  /*                          btree_slot                          */
+  /* ============================================================ */
+
+  /*
+  ** btree_slot
+  ** node 안에서 element 하나가 차지하는 자리이다. node 안의 삽입, 삭제, 분할, 병합은 자리를 memmove로 옮긴다.
+  ** trivially relocatable한 타입은 자리에 element를 바로 담고,
+  ** 그 외의 타입은 element를 따로 할당하고 자리에는 포인터만 담아서 자리를 memmove로 옮길 수 있게 한다.
+  */
+  template <class T, class Alloc, bool Inline = is_trivially_relocatable<T>::value>
+  struct btree_slot {
+    typedef T   slot_type;
+
+    static T& get(slot_type& slot) {
+      return (slot);
+    }
+    static void construct(Alloc& alloc, slot_type* slot, const T& value) {
+      alloc.construct(slot, value);
+    }
+    static void destroy(Alloc& alloc, slot_type* slot) {
+      alloc.destroy(slot);
+    }
+  };
+
+  template <class T, class Alloc>
+  struct btree_slot<T, Alloc, false> {
+    typedef T*  slot_type;
+
+    static T& get(slot_type& slot) {
+      return (*slot);
+    }
+    static void construct(Alloc& alloc, slot_type* slot, const T& value) {
+      T* ptr = alloc.allocate(1);
+      try {
+        alloc.construct(ptr, value);
+      } catch (...) {
+        alloc.deallocate(ptr, 1);
+        throw ;
+      }
+      *slot = ptr;
+    }
+    static void destroy(Alloc& alloc, slot_type* slot) {
+      alloc.destroy(*slot);
+      alloc.deallocate(*slot, 1);
+    }
+  };
+
+  /* ============================================================ */
+  /*                          btree_node                          */
+  /* ============================================================ */
+
+  /*
+  ** btree_node_base
+  ** leaf와 internal node가 공유하는 머리 부분이다.
+  ** position은 부모의 children 배열에서 이 node의 index이고, count는 leaf의 element 수 또는 internal node의 key 수이다.
+  */
+  struct btree_node_base {
+    btree_node_base*  parent;
+    unsigned short    position;
+    unsigned short    count;
+    bool              leaf;
+  };
+
+  /* leaf는 이웃한 leaf와 양방향으로 연결되어 있어서 iterator가 부모를 거치지 않고 다음 leaf로 넘어간다. */
+  struct btree_leaf_base : public btree_node_base {
+    btree_leaf_base*  prev;
+    btree_leaf_base*  next;
+  };
+
+  /* element를 담는 leaf. 모든 element는 leaf에만 있다. */
+  template <class Slot, std::size_t N>
+  struct btree_leaf : public btree_leaf_base {
+    typedef typename Slot::slot_type  slot_type;
+
+    ft::aligned_buffer<slot_type, N>  storage;
+
+    slot_type* slots() {
+      return (reinterpret_cast<slot_type*>(storage._bytes));
+    }
+  };
+
+  /*
+  ** key로 길을 안내하는 internal node. key가 count개, 자식이 count + 1개이다.
+  ** keys[i]는 children[i]의 모든 key보다 크고 children[i + 1]의 모든 key 이하이다.
+  ** element를 지워도 key는 그대로 두므로 keys[i]가 실제 element와 같지 않을 수 있다.
+  */
+  template <class KeySlot, std::size_t N>
+  struct btree_internal : public btree_node_base {
+    typedef typename KeySlot::slot_type  slot_type;
+
+    btree_node_base*                  children[N + 1];
+    ft::aligned_buffer<slot_type, N>  storage;
+
+    slot_type* keys() {
+      return (reinterpret_cast<slot_type*>(storage._bytes));
+    }
+  };
+
+  /*
+  ** node 하나가 Bytes byte 안에 담을 수 있는 자리 수. 자리마다 Extra byte(자식 포인터)가 더 필요할 수 있다.
+  ** 분할과 병합이 성립하도록 최소 3개, count가 unsigned short에 들어가도록 최대 4096개이다.
+  */
+  template <std::size_t Bytes, std::size_t Header, std::size_t Slot, std::size_t Extra>
+  struct btree_node_capacity {
+    static const std::size_t  fit = (Bytes > Header + Extra) ? (Bytes - Header - Extra) / (Slot + Extra) : 0;
+    static const std::size_t  value = (fit < 3) ? 3 : (fit > 4096 ? 4096 : fit);
+  };
+
+  /* ============================================================ */
+  /*                        btree_iterator                        */
+  /* ============================================================ */
+
+  /*
+  ** leaf와 그 안의 위치를 들고 있는 iterator. end()는 마지막 leaf의 count 위치이고, 빈 tree에서는 NULL이다.
+  ** 삽입과 삭제는 element를 node 사이로 옮기므로 모든 iterator를 무효화한다.
+  */
+  template <typename U, typename Leaf, typename Slot>
+  class btree_iterator {
+    public:
+    typedef U                                 value_type;
+    typedef value_type*                       pointer;
+    typedef value_type&                       reference;
+    typedef std::ptrdiff_t                    difference_type;
+    typedef ft::bidirectional_iterator_tag    iterator_category;
+
+    private:
+    Leaf*         _leaf;
+    std::size_t   _pos;
+
+    public:
+    btree_iterator() : _leaf(NULL), _pos(0) {}
+    btree_iterator(Leaf* leaf, std::size_t pos) : _leaf(leaf), _pos(pos) {}
+
+    Leaf*       leaf()     const { return (_leaf); }
+    std::size_t position() const { return (_pos); }
+    pointer     operator->() const { return (&Slot::get(_leaf->slots()[_pos])); }
+    reference   operator*()  const { return (Slot::get(_leaf->slots()[_pos])); }
+
+    btree_iterator& operator++() {
+      if (++_pos == _leaf->count && _leaf->next != NULL) {
+        _leaf = static_cast<Leaf*>(_leaf->next);
+        _pos = 0;
+      }
+      return (*this);
+    }
+    btree_iterator operator++(int) {
+      btree_iterator tmp(*this);
+      ++(*this);
+      return (tmp);
+    }
+
+    btree_iterator& operator--() {
+      if (_pos == 0) {
+        _leaf = static_cast<Leaf*>(_leaf->prev);
+        _pos = _leaf->count;
+      }
+      --_pos;
+      return (*this);
+    }
+    btree_iterator operator--(int) {
+      btree_iterator tmp(*this);
+      --(*this);
+      return (tmp);
+    }
+
+    template <typename T>
+    bool operator==(const btree_iterator<T, Leaf, Slot>& x) const {
+      return (_leaf == x.leaf() && _pos == x.position());
+    }
+    template <typename T>
+    bool operator!=(const btree_iterator<T, Leaf, Slot>& x) const {
+      return !(*this == x);
+    }
+
+    operator btree_iterator<const value_type, Leaf, Slot>(void) const {
+      return (btree_iterator<const value_type, Leaf, Slot>(_leaf, _pos));
+    }
+
+    friend bool operator==(const btree_iterator& lhs, const btree_iterator& rhs) {
+      return (lhs._leaf == rhs._leaf && lhs._pos == rhs._pos);
+    }
+    friend bool operator!=(const btree_iterator& lhs, const btree_iterator& rhs) {
+      return (!(lhs == rhs));
+    }
+  };
+
+  /* ============================================================ */
+  /*                            B+ tree                           */
+  /* ============================================================ */
+
+  /* node 안에서 key의 자리를 찾는 방법 */
+  struct btree_simd_search {};
+  struct btree_linear_search {};
+  struct btree_binary_search {};
+
+  /*
+  ** 4 byte 또는 8 byte 정수 key를 std::less로 비교하고 key가 연속해서 놓여 있으면 SIMD로,
+  ** 그 외의 산술 타입은 처음부터 차례로, 나머지 타입은 비교 비용이 클 수 있으므로 이분 탐색으로 찾는다.
+  */
+  template <class Key, class Compare, bool Contiguous>
+  struct btree_search_type {
+    typedef typename remove_cv<Key>::type   key_type;
+    static const bool simd = Contiguous && is_integral<key_type>::value
+      && (sizeof(key_type) == 4 || sizeof(key_type) == 8) && is_same<Compare, std::less<key_type> >::value;
+    static const bool linear = is_arithmetic<key_type>::value;
+  };
+  template <class Key, class Compare, bool Contiguous,
+    bool Simd = btree_search_type<Key, Compare, Contiguous>::simd,
+    bool Linear = btree_search_type<Key, Compare, Contiguous>::linear>
+  struct btree_search_tag                                           { typedef btree_binary_search type; };
+  template <class Key, class Compare, bool Contiguous, bool Linear>
+  struct btree_search_tag<Key, Compare, Contiguous, true, Linear>   { typedef btree_simd_search type; };
+  template <class Key, class Compare, bool Contiguous>
+  struct btree_search_tag<Key, Compare, Contiguous, false, true>    { typedef btree_linear_search type; };
+
+  /*
+  ** B+ tree
+  ** element는 모두 leaf에 순서대로 담기고, internal node는 key 사본으로 길만 안내한다.
+  ** node는 NodeBytes(기본 256 byte, cache line 4개)에 맞춰 element와 key를 최대한 채우므로
+  ** 검색할 때 따라가는 포인터가 node 수만큼으로 줄고, element마다 포인터를 두지 않아 메모리도 적게 쓴다.
+  ** node는 cache line 경계에서 시작하도록 할당해서 node 하나가 NodeBytes / 64개의 cache line만 차지한다.
+  ** leaf와 internal node를 제외하면 할당하지 않으며, 빈 tree는 아무것도 할당하지 않는다.
+  ** KeyOfValue는 value에서 key를 꺼내는 함수 객체이고, key는 Compare로 비교한다.
+  */
+  template <class T, class Key, class KeyOfValue, class Compare, class Allocator, std::size_t NodeBytes = 256>
+  class btree {
+    public:
+    typedef T                                                           value_type;
+    typedef Key                                                         key_type;
+    typedef Compare                                                     key_compare;
+    typedef Allocator                                                   allocator_type;
+    typedef std::size_t                                                 size_type;
+    typedef std::ptrdiff_t                                              difference_type;
+
+    private:
+    typedef typename allocator_type::template rebind<value_type>::other value_allocator;
+    typedef typename allocator_type::template rebind<key_type>::other   key_allocator;
+    typedef btree_slot<value_type, value_allocator>                     value_slot;
+    typedef btree_slot<key_type, key_allocator>                         key_slot;
+    typedef typename value_slot::slot_type                              value_slot_type;
+    typedef typename key_slot::slot_type                                key_slot_type;
+
+    public:
+    static const size_type  leaf_capacity =
+      btree_node_capacity<NodeBytes, sizeof(btree_leaf_base), sizeof(value_slot_type), 0>::value;
+    static const size_type  internal_capacity =
+      btree_node_capacity<NodeBytes, sizeof(btree_node_base), sizeof(key_slot_type), sizeof(btree_node_base*)>::value;
+
+    typedef btree_leaf<value_slot, leaf_capacity>                       leaf_type;
+    typedef btree_internal<key_slot, internal_capacity>                 internal_type;
+    typedef btree_iterator<value_type, leaf_type, value_slot>           iterator;
+    typedef btree_iterator<const value_type, leaf_type, value_slot>     const_iterator;
+
+    private:
+    typedef typename allocator_type::template rebind<char>::other           byte_allocator;
+    typedef typename btree_search_tag<key_type, key_compare,
+      is_same<value_type, key_type>::value && !is_same<value_slot_type, value_type*>::value>::type  leaf_search;
+    typedef typename btree_search_tag<key_type, key_compare,
+      !is_same<key_slot_type, key_type*>::value>::type                                             internal_search;
+
+    static const size_type  min_leaf = leaf_capacity / 2;
+    static const size_type  min_internal = internal_capacity / 2;
+    static const size_type  max_height = 64;
+    static const size_type  cache_line_size = 64;
+
+    btree_node_base*  _root;
+    leaf_type*        _leftmost;
+    leaf_type*        _rightmost;
+    size_type         _size;
+    key_compare       _comp;
+    KeyOfValue        _key_of;
+    allocator_type    _alloc;
+
+    public:
+    btree(const key_compare& comp, const allocator_type& alloc)
+      : _root(NULL), _leftmost(NULL), _rightmost(NULL), _size(0), _comp(comp), _key_of(), _alloc(alloc) {}
+    /* element를 순서대로 오른쪽 끝에 붙여서 만든다. 끝에 붙이는 분할은 왼쪽 leaf를 가득 채운 채로 남긴다. */
+    btree(const btree& ref)
+      : _root(NULL), _leftmost(NULL), _rightmost(NULL), _size(0), _comp(ref._comp), _key_of(), _alloc(ref._alloc) {
+        try {
+          for (const_iterator it = ref.begin(); it != ref.end(); ++it)
+            append(*it);
+        } catch (...) {
+          clear();
+          throw ;
+        }
+      }
+    ~btree() {
+      clear();
+    }
+
+    btree& operator=(const btree& ref) {
+      if (this != &ref) {
+        btree tmp(ref);
+        swap(tmp);
+      }
+      return (*this);
+    }
+
+    /* ============================================================ */
+    /*                          Iterators                           */
+    /* ============================================================ */
+
+    iterator begin() {
+      return (iterator(_leftmost, 0));
+    }
+    const_iterator begin() const {
+      return (const_iterator(_leftmost, 0));
+    }
+
+    iterator end() {
+      return (iterator(_rightmost, _rightmost == NULL ? 0 : _rightmost->count));
+    }
+    const_iterator end() const {
+      return (const_iterator(_rightmost, _rightmost == NULL ? 0 : _rightmost->count));
+    }
+
+    /* ============================================================ */
+    /*                           Capacity                           */
+    /* ============================================================ */
+
+    bool empty() const {
+      return (_size == 0);
+    }
+
+    size_type size() const {
+      return (_size);
+    }
+
+    size_type max_size() const {
+      return (value_allocator(_alloc).max_size());
+    }
+
+    /* ============================================================ */
+    /*                          Modifiers                           */
+    /* ============================================================ */
+
+    ft::pair<iterator, bool> insert(const value_type& value) {
+      const key_type& key = _key_of(value);
+      if (_root == NULL)
+        return (ft::make_pair(insert_at(NULL, 0, value), true));
+      leaf_type* leaf = find_leaf(key);
+      size_type pos = leaf_lower(leaf, key, leaf_search());
+      if (pos < leaf->count && !_comp(key, leaf_key(leaf, pos)))
+        return (ft::make_pair(iterator(leaf, pos), false));
+      return (ft::make_pair(insert_at(leaf, pos, value), true));
+    }
+    /*
+    ** hint가 end()이고 value가 가장 큰 key보다 크면 검색 없이 마지막 leaf 끝에 붙인다.
+    ** hint가 leaf의 첫 자리가 아니고 value가 hint 바로 앞에 들어갈 자리이면 그 자리에 넣는다.
+    ** leaf의 첫 자리는 부모의 key와 비교해야 알 수 있으므로 hint 없이 삽입한다.
+    */
+    iterator insert(iterator hint, const value_type& value) {
+      const key_type& key = _key_of(value);
+      if (hint == end()) {
+        if (_rightmost != NULL && _comp(leaf_key(_rightmost, _rightmost->count - 1), key))
+          return (insert_at(_rightmost, _rightmost->count, value));
+      } else if (hint.position() > 0 && _comp(key, leaf_key(hint.leaf(), hint.position()))
+          && _comp(leaf_key(hint.leaf(), hint.position() - 1), key)) {
+        return (insert_at(hint.leaf(), hint.position(), value));
+      }
+      return (insert(value).first);
+    }
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+      for (; first != last; ++first)
+        insert(end(), *first);
+    }
+
+    /* 다음 element를 가리키는 iterator를 반환한다. */
+    iterator erase(iterator position) {
+      return (erase_at(position.leaf(), position.position()));
+    }
+    size_type erase(const key_type& key) {
+      iterator it = find(key);
+      if (it == end())
+        return (0);
+      erase(it);
+      return (1);
+    }
+    /* 지울 때마다 다음 element의 iterator를 새로 받아서 k개를 지운다. 지운 element의 수를 반환한다. */
+    size_type erase(iterator first, iterator last) {
+      if (first == begin() && last == end()) {
+        size_type count = _size;
+        clear();
+        return (count);
+      }
+      size_type count = static_cast<size_type>(ft::distance(first, last));
+      for (size_type i = 0; i < count; ++i)
+        first = erase(first);
+      return (count);
+    }
+
+    void swap(btree& ref) {
+      std::swap(_root, ref._root);
+      std::swap(_leftmost, ref._leftmost);
+      std::swap(_rightmost, ref._rightmost);
+      std::swap(_size, ref._size);
+      std::swap(_comp, ref._comp);
+      std::swap(_alloc, ref._alloc);
+    }
+
+    void clear() {
+      if (_root != NULL)
+        destroy_node(_root);
+      _root = NULL;
+      _leftmost = NULL;
+      _rightmost = NULL;
+      _size = 0;
+    }
+
+    /* ============================================================ */
+    /*                          Operations                          */
+    /* ============================================================ */
+
+    iterator find(const key_type& key) {
+      iterator it = lower_bound(key);
+      if (it == end() || _comp(key, _key_of(*it)))
+        return (end());
+      return (it);
+    }
+    const_iterator find(const key_type& key) const {
+      return (const_cast<btree*>(this)->find(key));
+    }
+
+    iterator lower_bound(const key_type& key) {
+      if (_root == NULL)
+        return (end());
+      leaf_type* leaf = find_leaf(key);
+      return (make_iterator(leaf, leaf_lower(leaf, key, leaf_search())));
+    }
+    const_iterator lower_bound(const key_type& key) const {
+      return (const_cast<btree*>(this)->lower_bound(key));
+    }
+
+    iterator upper_bound(const key_type& key) {
+      iterator it = lower_bound(key);
+      if (it != end() && !_comp(key, _key_of(*it)))
+        ++it;
+      return (it);
+    }
+    const_iterator upper_bound(const key_type& key) const {
+      return (const_cast<btree*>(this)->upper_bound(key));
+    }
+
+    ft::pair<iterator, iterator> equal_range(const key_type& key) {
+      iterator first = lower_bound(key);
+      iterator last = first;
+      if (last != end() && !_comp(key, _key_of(*last)))
+        ++last;
+      return (ft::make_pair(first, last));
+    }
+    ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+      ft::pair<iterator, iterator> range = const_cast<btree*>(this)->equal_range(key);
+      return (ft::make_pair(const_iterator(range.first), const_iterator(range.second)));
+    }
+
+    /* ============================================================ */
+    /*                          Allocator                           */
+    /* ============================================================ */
+
+    allocator_type get_allocator() const {
+      return (_alloc);
+    }
+
+    /* ============================================================ */
+    /*                   private member function                    */
+    /* ============================================================ */
+
+    private:
+    const key_type& leaf_key(leaf_type* leaf, size_type pos) const {
+      return (_key_of(value_slot::get(leaf->slots()[pos])));
+    }
+
+    static const key_type& internal_key(internal_type* node, size_type pos) {
+      return (key_slot::get(node->keys()[pos]));
+    }
+
+    static internal_type* as_internal(btree_node_base* node) {
+      return (static_cast<internal_type*>(node));
+    }
+
+    /* leaf의 끝 위치는 다음 leaf의 첫 위치로 바꾼다. 마지막 leaf의 끝은 end()이다. */
+    static iterator make_iterator(leaf_type* leaf, size_type pos) {
+      if (pos == leaf->count && leaf->next != NULL)
+        return (iterator(static_cast<leaf_type*>(leaf->next), 0));
+      return (iterator(leaf, pos));
+    }
+
+    /* key가 있어야 할 leaf. internal node에서는 key 이하인 key의 수가 내려갈 자식의 index이다. */
+    leaf_type* find_leaf(const key_type& key) const {
+      btree_node_base* node = _root;
+      while (!node->leaf) {
+        internal_type* internal = as_internal(node);
+        node = internal->children[internal_upper(internal, key, internal_search())];
+      }
+      return (static_cast<leaf_type*>(node));
+    }
+
+    /* leaf에서 key보다 작은 element의 수 */
+    size_type leaf_lower(leaf_type* leaf, const key_type& key, btree_simd_search) const {
+      return (ft::simd_count_less(reinterpret_cast<const key_type*>(leaf->slots()), leaf->count, key));
+    }
+    size_type leaf_lower(leaf_type* leaf, const key_type& key, btree_linear_search) const {
+      size_type pos = 0;
+      while (pos < leaf->count && _comp(leaf_key(leaf, pos), key))
+        ++pos;
+      return (pos);
+    }
+    size_type leaf_lower(leaf_type* leaf, const key_type& key, btree_binary_search) const {
+      size_type lo = 0;
+      size_type hi = leaf->count;
+      while (lo < hi) {
+        size_type mid = lo + (hi - lo) / 2;
+        if (_comp(leaf_key(leaf, mid), key))
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      return (lo);
+    }
+
+    /* internal node에서 key 이하인 key의 수 */
+    size_type internal_upper(internal_type* node, const key_type& key, btree_simd_search) const {
+      return (ft::simd_count_less_equal(reinterpret_cast<const key_type*>(node->keys()), node->count, key));
+    }
+    size_type internal_upper(internal_type* node, const key_type& key, btree_linear_search) const {
+      size_type pos = 0;
+      while (pos < node->count && !_comp(key, internal_key(node, pos)))
+        ++pos;
+      return (pos);
+    }
+    size_type internal_upper(internal_type* node, const key_type& key, btree_binary_search) const {
+      size_type lo = 0;
+      size_type hi = node->count;
+      while (lo < hi) {
+        size_type mid = lo + (hi - lo) / 2;
+        if (_comp(key, internal_key(node, mid)))
+          hi = mid;
+        else
+          lo = mid + 1;
+      }
+      return (lo);
+    }
+
+    /* ============================================================ */
+    /*                        node management                       */
+    /* ============================================================ */
+
+    /*
+    ** bytes 크기의 node를 cache line 경계에 맞춰 할당한다.
+    ** allocator는 정렬을 보장하지 않으므로 cache line 하나만큼 더 할당하고,
+    ** node 바로 앞 byte에 할당받은 주소부터 node까지의 거리(1 ~ 64)를 적어둔다.
+    */
+    void* allocate_aligned(size_type bytes) {
+      byte_allocator alloc(_alloc);
+      char* raw = alloc.allocate(bytes + cache_line_size);
+      size_type offset = cache_line_size - reinterpret_cast<std::size_t>(raw) % cache_line_size;
+      char* ptr = raw + offset;
+      ptr[-1] = static_cast<char>(offset);
+      return (ptr);
+    }
+
+    void deallocate_aligned(void* node, size_type bytes) {
+      byte_allocator alloc(_alloc);
+      char* ptr = static_cast<char*>(node);
+      alloc.deallocate(ptr - static_cast<unsigned char>(ptr[-1]), bytes + cache_line_size);
+    }
+
+    leaf_type* allocate_leaf() {
+      leaf_type* leaf = static_cast<leaf_type*>(allocate_aligned(sizeof(leaf_type)));
+      leaf->parent = NULL;
+      leaf->position = 0;
+      leaf->count = 0;
+      leaf->leaf = true;
+      leaf->prev = NULL;
+      leaf->next = NULL;
+      return (leaf);
+    }
+
+    internal_type* allocate_internal() {
+      internal_type* node = static_cast<internal_type*>(allocate_aligned(sizeof(internal_type)));
+      node->parent = NULL;
+      node->position = 0;
+      node->count = 0;
+      node->leaf = false;
+      return (node);
+    }
+
+    void deallocate_node(btree_node_base* node) {
+      if (node->leaf)
+        deallocate_aligned(static_cast<leaf_type*>(node), sizeof(leaf_type));
+      else
+        deallocate_aligned(as_internal(node), sizeof(internal_type));
+    }
+
+    /* node와 그 아래의 element, key, node를 모두 해제한다. */
+    void destroy_node(btree_node_base* node) {
+      if (node->leaf) {
+        value_allocator alloc(_alloc);
+        leaf_type* leaf = static_cast<leaf_type*>(node);
+        for (size_type i = 0; i < leaf->count; ++i)
+          value_slot::destroy(alloc, leaf->slots() + i);
+      } else {
+        key_allocator alloc(_alloc);
+        internal_type* internal = as_internal(node);
+        for (size_type i = 0; i <= internal->count; ++i)
+          destroy_node(internal->children[i]);
+        for (size_type i = 0; i < internal->count; ++i)
+          key_slot::destroy(alloc, internal->keys() + i);
+      }
+      deallocate_node(node);
+    }
+
+    /* children[first, last]의 부모와 위치를 다시 적는다. */
+    static void adopt_children(internal_type* node, size_type first, size_type last) {
+      for (size_type i = first; i <= last; ++i) {
+        node->children[i]->parent = node;
+        node->children[i]->position = static_cast<unsigned short>(i);
+      }
+    }
+
+    /* 자리를 옮긴다. 자리는 항상 memmove로 옮길 수 있다. */
+    template <class Slot>
+    static void move_slots(Slot* dest, Slot* first, size_type n) {
+      if (n > 0)
+        std::memmove(static_cast<void*>(dest), static_cast<const void*>(first), n * sizeof(Slot));
+    }
+
+    /* 분할에 쓸 node를 미리 할당해 두어서, 구조를 바꾸는 도중에는 예외가 발생하지 않게 한다. */
+    struct spare_nodes {
+      internal_type*  nodes[max_height];
+      size_type       count;
+
+      spare_nodes() : count(0) {}
+      internal_type* pop() {
+        return (nodes[--count]);
+      }
+    };
+
+    /* ============================================================ */
+    /*                            insert                            */
+    /* ============================================================ */
+
+    /* 검색 없이 오른쪽 끝에 붙인다. value는 가장 큰 key보다 커야 한다. */
+    void append(const value_type& value) {
+      insert_at(_rightmost, _rightmost == NULL ? 0 : _rightmost->count, value);
+    }
+
+    /*
+    ** leaf의 pos 자리에 value를 넣는다. leaf가 NULL이면 root leaf를 만든다.
+    ** value를 먼저 임시 자리에 생성하고, 필요한 node와 key를 모두 준비한 뒤에 구조를 바꾼다.
+    ** 예외가 발생하면 tree는 바뀌지 않는다.
+    */
+    iterator insert_at(leaf_type* leaf, size_type pos, const value_type& value) {
+      value_allocator alloc(_alloc);
+      ft::aligned_buffer<value_slot_type, 1> tmp;
+      value_slot_type* slot = reinterpret_cast<value_slot_type*>(tmp._bytes);
+      value_slot::construct(alloc, slot, value);
+      try {
+        if (leaf == NULL) {
+          leaf = allocate_leaf();
+          _root = leaf;
+          _leftmost = leaf;
+          _rightmost = leaf;
+        } else if (leaf->count == leaf_capacity) {
+          return (split_leaf(leaf, pos, slot));
+        }
+      } catch (...) {
+        value_slot::destroy(alloc, slot);
+        throw ;
+      }
+      value_slot_type* slots = leaf->slots();
+      move_slots(slots + pos + 1, slots + pos, leaf->count - pos);
+      std::memcpy(static_cast<void*>(slots + pos), static_cast<const void*>(slot), sizeof(value_slot_type));
+      ++leaf->count;
+      ++_size;
+      return (iterator(leaf, pos));
+    }
+
+    /*
+    ** 가득 찬 leaf에 slot을 넣으면서 leaf를 둘로 나누고, 오른쪽 leaf의 첫 key를 부모에 넣는다.
+    ** 오른쪽 끝 leaf의 끝에 넣을 때는 왼쪽을 가득 채운 채로 새 element만 오른쪽으로 보내고,
+    ** 왼쪽 끝 leaf의 앞에 넣을 때는 반대로 한다. 정렬된 입력을 넣어도 leaf가 반만 차지 않는다.
+    ** 그래서 양 끝 leaf는 절반보다 적게 차 있을 수 있지만, 삭제할 때 합치는 조건은 그대로 성립한다.
+    */
+    iterator split_leaf(leaf_type* leaf, size_type pos, value_slot_type* slot) {
+      size_type split;
+      if (leaf == _rightmost && pos == leaf_capacity)
+        split = leaf_capacity;
+      else if (leaf == _leftmost && pos == 0)
+        split = 1;
+      else
+        split = (leaf_capacity + 1) / 2;
+      spare_nodes spare;
+      leaf_type* right = NULL;
+      key_allocator alloc(_alloc);
+      ft::aligned_buffer<key_slot_type, 1> tmp;
+      key_slot_type* separator = reinterpret_cast<key_slot_type*>(tmp._bytes);
+      try {
+        reserve_internal(leaf, spare);
+        right = allocate_leaf();
+        if (split == pos)
+          key_slot::construct(alloc, separator, _key_of(value_slot::get(*slot)));
+        else
+          key_slot::construct(alloc, separator, leaf_key(leaf, split < pos ? split : split - 1));
+      } catch (...) {
+        if (right != NULL)
+          deallocate_node(right);
+        while (spare.count > 0)
+          deallocate_node(spare.pop());
+        throw ;
+      }
+      value_slot_type* slots = leaf->slots();
+      value_slot_type* rslots = right->slots();
+      if (pos < split) {
+        move_slots(rslots, slots + split - 1, leaf_capacity - split + 1);
+        move_slots(slots + pos + 1, slots + pos, split - 1 - pos);
+        std::memcpy(static_cast<void*>(slots + pos), static_cast<const void*>(slot), sizeof(value_slot_type));
+      } else {
+        move_slots(rslots, slots + split, pos - split);
+        std::memcpy(static_cast<void*>(rslots + pos - split), static_cast<const void*>(slot), sizeof(value_slot_type));
+        move_slots(rslots + pos - split + 1, slots + pos, leaf_capacity - pos);
+      }
+      leaf->count = static_cast<unsigned short>(split);
+      right->count = static_cast<unsigned short>(leaf_capacity + 1 - split);
+      right->prev = leaf;
+      right->next = leaf->next;
+      if (leaf->next != NULL)
+        leaf->next->prev = right;
+      else
+        _rightmost = right;
+      leaf->next = right;
+      ++_size;
+      insert_into_parent(leaf, separator, right, spare);
+      if (pos < split)
+        return (iterator(leaf, pos));
+      return (iterator(right, pos - split));
+    }
+
+    /* node가 분할될 때 새로 필요한 internal node를 모두 할당한다. 가득 찬 조상마다 하나, root까지 가득 차면 새 root 하나이다. */
+    void reserve_internal(btree_node_base* node, spare_nodes& spare) {
+      size_type needed = 0;
+      btree_node_base* parent = node->parent;
+      for (; parent != NULL && parent->count == internal_capacity; parent = parent->parent)
+        ++needed;
+      if (parent == NULL)
+        ++needed;
+      while (spare.count < needed)
+        spare.nodes[spare.count++] = allocate_internal();
+    }
+
+    /* left의 부모에 separator와 새 형제 right를 넣는다. 부모가 가득 차 있으면 부모도 나눈다. */
+    void insert_into_parent(btree_node_base* left, key_slot_type* separator, btree_node_base* right, spare_nodes& spare) {
+      internal_type* parent = as_internal(left->parent);
+      if (parent == NULL) {
+        internal_type* root = spare.pop();
+        std::memcpy(static_cast<void*>(root->keys()), static_cast<const void*>(separator), sizeof(key_slot_type));
+        root->children[0] = left;
+        root->children[1] = right;
+        root->count = 1;
+        adopt_children(root, 0, 1);
+        _root = root;
+        return ;
+      }
+      size_type idx = left->position;
+      if (parent->count < internal_capacity) {
+        move_slots(parent->keys() + idx + 1, parent->keys() + idx, parent->count - idx);
+        move_slots(parent->children + idx + 2, parent->children + idx + 1, parent->count - idx);
+        std::memcpy(static_cast<void*>(parent->keys() + idx), static_cast<const void*>(separator), sizeof(key_slot_type));
+        parent->children[idx + 1] = right;
+        ++parent->count;
+        adopt_children(parent, idx + 1, parent->count);
+        return ;
+      }
+      split_internal(parent, idx, separator, right, spare);
+    }
+
+    /*
+    ** 가득 찬 internal node에 key와 자식을 넣으면서 둘로 나누고, 가운데 key를 부모로 올린다.
+    ** key cap + 1개와 자식 cap + 2개를 임시 배열에 순서대로 모은 뒤 양쪽에 나눠 담는다.
+    */
+    void split_internal(internal_type* node, size_type idx, key_slot_type* separator, btree_node_base* child, spare_nodes& spare) {
+      ft::aligned_buffer<key_slot_type, internal_capacity + 1> key_buffer;
+      key_slot_type* keys = reinterpret_cast<key_slot_type*>(key_buffer._bytes);
+      btree_node_base* children[internal_capacity + 2];
+      move_slots(keys, node->keys(), idx);
+      std::memcpy(static_cast<void*>(keys + idx), static_cast<const void*>(separator), sizeof(key_slot_type));
+      move_slots(keys + idx + 1, node->keys() + idx, internal_capacity - idx);
+      move_slots(children, node->children, idx + 1);
+      children[idx + 1] = child;
+      move_slots(children + idx + 2, node->children + idx + 1, internal_capacity - idx);
+      size_type total = internal_capacity + 1;
+      size_type mid = total / 2;
+      internal_type* right = spare.pop();
+      move_slots(node->keys(), keys, mid);
+      move_slots(node->children, children, mid + 1);
+      node->count = static_cast<unsigned short>(mid);
+      adopt_children(node, 0, mid);
+      move_slots(right->keys(), keys + mid + 1, total - mid - 1);
+      move_slots(right->children, children + mid + 1, total - mid);
+      right->count = static_cast<unsigned short>(total - mid - 1);
+      adopt_children(right, 0, right->count);
+      insert_into_parent(node, keys + mid, right, spare);
+    }
+
+    /* ============================================================ */
+    /*                            erase                             */
+    /* ============================================================ */
+
+    /*
+    ** leaf의 pos 자리 element를 지우고 다음 element의 iterator를 반환한다.
+    ** leaf가 절반 아래로 줄면 형제에게서 element를 하나 빌리거나 형제와 합친다.
+    ** 빌릴 때는 부모의 key를 새 경계로 바꿔야 하므로 key 사본을 먼저 만들고, 만드는 데 실패하면 tree는 바뀌지 않는다.
+    ** 합칠 때는 부모에서 key 하나와 자식 하나가 빠지고, 부모가 줄어들면 위로 올라가며 균형을 맞춘다.
+    */
+    iterator erase_at(leaf_type* leaf, size_type pos) {
+      internal_type* parent = as_internal(leaf->parent);
+      if (parent == NULL || leaf->count > min_leaf) {
+        remove_slot(leaf, pos);
+        if (leaf->count == 0) {
+          deallocate_node(leaf);
+          _root = NULL;
+          _leftmost = NULL;
+          _rightmost = NULL;
+          return (end());
+        }
+        return (make_iterator(leaf, pos));
+      }
+      size_type idx = leaf->position;
+      leaf_type* left = (idx > 0) ? static_cast<leaf_type*>(parent->children[idx - 1]) : NULL;
+      leaf_type* right = (idx < parent->count) ? static_cast<leaf_type*>(parent->children[idx + 1]) : NULL;
+      key_allocator alloc(_alloc);
+      ft::aligned_buffer<key_slot_type, 1> tmp;
+      key_slot_type* separator = reinterpret_cast<key_slot_type*>(tmp._bytes);
+      if (left != NULL && left->count > min_leaf) {
+        key_slot::construct(alloc, separator, leaf_key(left, left->count - 1));
+        remove_slot(leaf, pos);
+        value_slot_type* slots = leaf->slots();
+        move_slots(slots + 1, slots, leaf->count);
+        std::memcpy(static_cast<void*>(slots), static_cast<const void*>(left->slots() + left->count - 1), sizeof(value_slot_type));
+        --left->count;
+        ++leaf->count;
+        replace_key(parent, idx - 1, separator);
+        return (make_iterator(leaf, pos + 1));
+      }
+      if (right != NULL && right->count > min_leaf) {
+        key_slot::construct(alloc, separator, leaf_key(right, 1));
+        remove_slot(leaf, pos);
+        std::memcpy(static_cast<void*>(leaf->slots() + leaf->count), static_cast<const void*>(right->slots()), sizeof(value_slot_type));
+        move_slots(right->slots(), right->slots() + 1, right->count - 1);
+        --right->count;
+        ++leaf->count;
+        replace_key(parent, idx, separator);
+        return (make_iterator(leaf, pos));
+      }
+      remove_slot(leaf, pos);
+      if (left != NULL) {
+        size_type offset = left->count;
+        merge_leaves(left, leaf);
+        remove_child(parent, idx - 1, true);
+        rebalance_internal(parent);
+        return (make_iterator(left, offset + pos));
+      }
+      merge_leaves(leaf, right);
+      remove_child(parent, idx, true);
+      rebalance_internal(parent);
+      return (make_iterator(leaf, pos));
+    }
+
+    void remove_slot(leaf_type* leaf, size_type pos) {
+      value_allocator alloc(_alloc);
+      value_slot_type* slots = leaf->slots();
+      value_slot::destroy(alloc, slots + pos);
+      move_slots(slots + pos, slots + pos + 1, leaf->count - pos - 1);
+      --leaf->count;
+      --_size;
+    }
+
+    void replace_key(internal_type* node, size_type pos, key_slot_type* key) {
+      key_allocator alloc(_alloc);
+      key_slot::destroy(alloc, node->keys() + pos);
+      std::memcpy(static_cast<void*>(node->keys() + pos), static_cast<const void*>(key), sizeof(key_slot_type));
+    }
+
+    /* right의 element를 left 뒤에 붙이고 right를 leaf 연결에서 빼서 해제한다. */
+    void merge_leaves(leaf_type* left, leaf_type* right) {
+      move_slots(left->slots() + left->count, right->slots(), right->count);
+      left->count = static_cast<unsigned short>(left->count + right->count);
+      left->next = right->next;
+      if (right->next != NULL)
+        right->next->prev = left;
+      else
+        _rightmost = left;
+      deallocate_node(right);
+    }
+
+    /* keys[pos]와 children[pos + 1]을 뺀다. key를 다른 node로 옮긴 경우에는 파괴하지 않는다. */
+    void remove_child(internal_type* node, size_type pos, bool destroy_key) {
+      if (destroy_key) {
+        key_allocator alloc(_alloc);
+        key_slot::destroy(alloc, node->keys() + pos);
+      }
+      move_slots(node->keys() + pos, node->keys() + pos + 1, node->count - pos - 1);
+      move_slots(node->children + pos + 1, node->children + pos + 2, node->count - pos - 1);
+      --node->count;
+      adopt_children(node, pos + 1, node->count);
+    }
+
+    /*
+    ** 절반 아래로 줄어든 internal node의 균형을 맞춘다.
+    ** 형제에게 여유가 있으면 부모의 key를 거쳐 key와 자식을 하나 옮기고, 없으면 부모의 key를 가운데에 두고 형제와 합친다.
+    ** root는 자식이 하나만 남으면 그 자식이 root가 된다. key를 옮기기만 하므로 예외가 발생하지 않는다.
+    */
+    void rebalance_internal(internal_type* node) {
+      while (true) {
+        if (node == _root) {
+          if (node->count == 0) {
+            _root = node->children[0];
+            _root->parent = NULL;
+            _root->position = 0;
+            deallocate_node(node);
+          }
+          return ;
+        }
+        if (node->count >= min_internal)
+          return ;
+        internal_type* parent = as_internal(node->parent);
+        size_type idx = node->position;
+        internal_type* left = (idx > 0) ? as_internal(parent->children[idx - 1]) : NULL;
+        internal_type* right = (idx < parent->count) ? as_internal(parent->children[idx + 1]) : NULL;
+        if (left != NULL && left->count > min_internal) {
+          move_slots(node->keys() + 1, node->keys(), node->count);
+          move_slots(node->children + 1, node->children, node->count + 1);
+          move_slots(node->keys(), parent->keys() + idx - 1, 1);
+          move_slots(parent->keys() + idx - 1, left->keys() + left->count - 1, 1);
+          node->children[0] = left->children[left->count];
+          --left->count;
+          ++node->count;
+          adopt_children(node, 0, node->count);
+          return ;
+        }
+        if (right != NULL && right->count > min_internal) {
+          move_slots(node->keys() + node->count, parent->keys() + idx, 1);
+          move_slots(parent->keys() + idx, right->keys(), 1);
+          node->children[node->count + 1] = right->children[0];
+          ++node->count;
+          adopt_children(node, node->count, node->count);
+          move_slots(right->keys(), right->keys() + 1, right->count - 1);
+          move_slots(right->children, right->children + 1, right->count);
+          --right->count;
+          adopt_children(right, 0, right->count);
+          return ;
+        }
+        if (left != NULL) {
+          merge_internal(left, parent, idx - 1, node);
+        } else {
+          merge_internal(node, parent, idx, right);
+        }
+        node = parent;
+      }
+    }
+
+    /* parent의 keys[pos]를 가운데에 두고 right를 left 뒤에 붙인 뒤 right를 해제한다. */
+    void merge_internal(internal_type* left, internal_type* parent, size_type pos, internal_type* right) {
+      size_type offset = left->count;
+      move_slots(left->keys() + offset, parent->keys() + pos, 1);
+      move_slots(left->keys() + offset + 1, right->keys(), right->count);
+      move_slots(left->children + offset + 1, right->children, right->count + 1);
+      left->count = static_cast<unsigned short>(offset + 1 + right->count);
+      adopt_children(left, offset + 1, left->count);
+      deallocate_node(right);
+      remove_child(parent, pos, false);
+    }
+  };
+
+  template <class T, class Key, class KeyOfValue, class Compare, class Allocator, std::size_t NodeBytes>
+  const typename btree<T, Key, KeyOfValue, Compare, Allocator, NodeBytes>::size_type
+    btree<T, Key, KeyOfValue, Compare, Allocator, NodeBytes>::leaf_capacity;
+  template <class T, class Key, class KeyOfValue, class Compare, class Allocator, std::size_t NodeBytes>
+  const typename btree<T, Key, KeyOfValue, Compare, Allocator, NodeBytes>::size_type
+    btree<T, Key, KeyOfValue, Compare, Allocator, NodeBytes>::internal_capacity;
+  template <class T, class Key, class KeyOfValue, class Compare, class Allocator, std::size_t NodeBytes>
+  const typename btree<T, Key, KeyOfValue, Compare, Allocator, NodeBytes>::size_type
+    btree<T, Key, KeyOfValue, Compare, Allocator, NodeBytes>::min_leaf;
+  template <class T, class Key, class KeyOfValue, class Compare, class Allocator, std::size_t NodeBytes>
+  const typename btree<T, Key, KeyOfValue, Compare, Allocator, NodeBytes>::size_type
+    btree<T, Key, KeyOfValue, Compare, Allocator, NodeBytes>::min_internal;
+  template <class T, class Key, class KeyOfValue, class Compare, class Allocator, std::size_t NodeBytes>
+  const typename btree<T, Key, KeyOfValue, Compare, Allocator, NodeBytes>::size_type
+    btree<T, Key, KeyOfValue, Compare, Allocator, NodeBytes>::max_height;
+  template <class T, class Key, class KeyOfValue, class Compare, class Allocator, std::size_t NodeBytes>
+  const typename btree<T, Key, KeyOfValue, Compare, Allocator, NodeBytes>::size_type
+    btree<T, Key, KeyOfValue, Compare, Allocator, NodeBytes>::cache_line_size;
+}
+
+#endif
@@ -0,0 +1,241 @@
+#ifndef FLAT_TREE_HPP_
+# define FLAT_TREE_HPP_
+
+/*
+** flat_sort_unique, flat_merge_unique
+** flat_split_reference, flat_split_pointer, flat_split_iterator
+*/
+
+# include <cstddef>   // std::size_t, std::ptrdiff_t
+# include "algorithm.hpp"
+# include "iterator.hpp"
+# include "type_traits.hpp"
+# include "utility.hpp"
+
+namespace ft {
+
+  /* ============================================================ */
+  /*                       sort and merge                         */
+  /* ============================================================ */
+
+  /*
+  ** flat_sort_unique
+  ** c[from, end)를 comp로 정렬하고 같은 key 중 범위에서 먼저 나온 element만 남긴다.
+  ** 이미 정렬되어 있고 중복이 없는 범위는 한 번 훑어보기만 한다.
+  */
+  template <class Container, class Compare>
+  void flat_sort_unique(Container& c, typename Container::size_type from, Compare comp) {
+    typedef typename Container::iterator  iterator;
+    iterator first = c.begin() + from;
+    iterator last = c.end();
+    if (last - first < 2)
+      return ;
+    iterator it = first + 1;
+    while (it != last && comp(*(it - 1), *it))
+      ++it;
+    if (it == last)
+      return ;
+    Container buffer(first, last, c.get_allocator());
+    ft::stable_sort(first, last, buffer.begin(), comp);
+    iterator result = first;
+    for (it = first + 1; it != last; ++it) {
+      if (comp(*result, *it) && ++result != it)
+        *result = *it;
+    }
+    c.erase(result + 1, last);
+  }
+
+  /*
+  ** flat_merge_unique
+  ** 각각 정렬되어 있고 중복이 없는 c[0, mid)와 c[mid, end)를 O(n + m)에 합친다.
+  ** 같은 key가 양쪽에 있으면 앞쪽(원래 있던) element를 남긴다.
+  ** 새 element가 모두 뒤에 붙을 자리이면 아무것도 옮기지 않는다.
+  */
+  template <class Container, class Compare>
+  void flat_merge_unique(Container& c, typename Container::size_type mid, Compare comp) {
+    typedef typename Container::size_type size_type;
+    size_type n = c.size();
+    if (mid == 0 || mid == n || comp(c[mid - 1], c[mid]))
+      return ;
+    Container out(c.get_allocator());
+    out.reserve(n);
+    size_type i = 0;
+    size_type j = mid;
+    while (i < mid && j < n) {
+      if (comp(c[j], c[i])) {
+        out.push_back(c[j++]);
+      } else {
+        if (!comp(c[i], c[j]))
+          ++j;
+        out.push_back(c[i++]);
+      }
+    }
+    for (; i < mid; ++i)
+      out.push_back(c[i]);
+    for (; j < n; ++j)
+      out.push_back(c[j]);
+    c.swap(out);
+  }
+
+  /* ============================================================ */
+  /*                    key, value split storage                  */
+  /* ============================================================ */
+
+  template <class Key, class T>
+  struct flat_split_pointer;
+
+  /*
+  ** flat_split_reference
+  ** key 배열과 value 배열에 따로 놓인 element 하나를 pair처럼 보여주는 참조이다.
+  ** first는 key의, second는 mapped value의 참조이고, value_type으로 변환하면 복사본을 얻는다.
+  ** reverse_iterator가 &(*it)로 포인터를 얻으므로 operator&는 flat_split_pointer를 반환한다.
+  */
+  template <class Key, class T>
+  struct flat_split_reference {
+    typedef typename remove_cv<Key>::type   key_type;
+    typedef typename remove_cv<T>::type     mapped_type;
+
+    Key&  first;
+    T&    second;
+
+    flat_split_reference(Key& k, T& v) : first(k), second(v) {}
+    flat_split_reference(const flat_split_reference& ref) : first(ref.first), second(ref.second) {}
+
+    operator ft::pair<key_type, mapped_type>() const {
+      return (ft::pair<key_type, mapped_type>(first, second));
+    }
+
+    flat_split_pointer<Key, T> operator&() const {
+      return (flat_split_pointer<Key, T>(*this));
+    }
+
+    private:
+    flat_split_reference& operator=(const flat_split_reference&);
+  };
+
+  template <class Key1, class T1, class Key2, class T2>
+  bool operator==(const flat_split_reference<Key1, T1>& lhs, const flat_split_reference<Key2, T2>& rhs) {
+    return (lhs.first == rhs.first && lhs.second == rhs.second);
+  }
+  template <class Key1, class T1, class Key2, class T2>
+  bool operator!=(const flat_split_reference<Key1, T1>& lhs, const flat_split_reference<Key2, T2>& rhs) {
+    return (!(lhs == rhs));
+  }
+  template <class Key1, class T1, class Key2, class T2>
+  bool operator< (const flat_split_reference<Key1, T1>& lhs, const flat_split_reference<Key2, T2>& rhs) {
+    return (lhs.first < rhs.first || (!(rhs.first < lhs.first) && lhs.second < rhs.second));
+  }
+
+  /* it->first, it->second를 쓸 수 있도록 flat_split_reference를 담아두는 포인터이다. */
+  template <class Key, class T>
+  struct flat_split_pointer {
+    flat_split_reference<Key, T>  ref;
+
+    explicit flat_split_pointer(const flat_split_reference<Key, T>& r) : ref(r) {}
+
+    /* flat_split_reference가 operator&를 바꿨으므로 char 참조를 거쳐 실제 주소를 얻는다. */
+    const flat_split_reference<Key, T>* operator->() const {
+      return (reinterpret_cast<const flat_split_reference<Key, T>*>(&reinterpret_cast<const char&>(ref)));
+    }
+  };
+
+  /*
+  ** flat_split_iterator
+  ** key 배열과 value 배열의 같은 위치를 함께 가리키는 random access iterator이다.
+  ** 두 배열은 element가 메모리에 연속으로 놓여 있어야 한다.
+  */
+  template <class Key, class T>
+  class flat_split_iterator {
+    public:
+    typedef ft::pair<Key, typename remove_cv<T>::type>  value_type;
+    typedef flat_split_reference<const Key, T>          reference;
+    typedef flat_split_pointer<const Key, T>            pointer;
+    typedef std::ptrdiff_t                              difference_type;
+    typedef ft::random_access_iterator_tag              iterator_category;
+
+    private:
+    const Key*  _key;
+    T*          _value;
+
+    public:
+    flat_split_iterator() : _key(NULL), _value(NULL) {}
+    flat_split_iterator(const Key* key, T* value) : _key(key), _value(value) {}
+    /* iterator에서 const_iterator로 변환한다. */
+    template <class U>
+    flat_split_iterator(const flat_split_iterator<Key, U>& it) : _key(it.key_base()), _value(it.value_base()) {}
+
+    const Key*  key_base()   const { return (_key); }
+    T*          value_base() const { return (_value); }
+
+    reference operator*() const {
+      return (reference(*_key, *_value));
+    }
+    pointer operator->() const {
+      return (pointer(operator*()));
+    }
+    reference operator[](difference_type n) const {
+      return (reference(_key[n], _value[n]));
+    }
+
+    flat_split_iterator& operator++() {
+      ++_key;
+      ++_value;
+      return (*this);
+    }
+    flat_split_iterator operator++(int) {
+      flat_split_iterator tmp(*this);
+      ++(*this);
+      return (tmp);
+    }
+    flat_split_iterator& operator--() {
+      --_key;
+      --_value;
+      return (*this);
+    }
+    flat_split_iterator operator--(int) {
+      flat_split_iterator tmp(*this);
+      --(*this);
+      return (tmp);
+    }
+    flat_split_iterator& operator+=(difference_type n) {
+      _key += n;
+      _value += n;
+      return (*this);
+    }
+    flat_split_iterator& operator-=(difference_type n) {
+      _key -= n;
+      _value -= n;
+      return (*this);
+    }
+    flat_split_iterator operator+(difference_type n) const {
+      return (flat_split_iterator(_key + n, _value + n));
+    }
+    flat_split_iterator operator-(difference_type n) const {
+      return (flat_split_iterator(_key - n, _value - n));
+    }
+  };
+
+  template <class Key, class T1, class T2>
+  bool operator==(const flat_split_iterator<Key, T1>& lhs, const flat_split_iterator<Key, T2>& rhs) { return (lhs.key_base() == rhs.key_base()); }
+  template <class Key, class T1, class T2>
+  bool operator!=(const flat_split_iterator<Key, T1>& lhs, const flat_split_iterator<Key, T2>& rhs) { return (lhs.key_base() != rhs.key_base()); }
+  template <class Key, class T1, class T2>
+  bool operator< (const flat_split_iterator<Key, T1>& lhs, const flat_split_iterator<Key, T2>& rhs) { return (lhs.key_base() < rhs.key_base()); }
+  template <class Key, class T1, class T2>
+  bool operator> (const flat_split_iterator<Key, T1>& lhs, const flat_split_iterator<Key, T2>& rhs) { return (lhs.key_base() > rhs.key_base()); }
+  template <class Key, class T1, class T2>
+  bool operator<=(const flat_split_iterator<Key, T1>& lhs, const flat_split_iterator<Key, T2>& rhs) { return (lhs.key_base() <= rhs.key_base()); }
+  template <class Key, class T1, class T2>
+  bool operator>=(const flat_split_iterator<Key, T1>& lhs, const flat_split_iterator<Key, T2>& rhs) { return (lhs.key_base() >= rhs.key_base()); }
+
+  template <class Key, class T1, class T2>
+  typename flat_split_iterator<Key, T1>::difference_type operator-(const flat_split_iterator<Key, T1>& lhs, const flat_split_iterator<Key, T2>& rhs) {
+    return (lhs.key_base() - rhs.key_base());
+  }
+  template <class Key, class T>
+  flat_split_iterator<Key, T> operator+(typename flat_split_iterator<Key, T>::difference_type n, const flat_split_iterator<Key, T>& it) {
+    return (it + n);
+  }
+}
+
+#endif
@@ -4,11 +4,15 @@
 /*
 ** iterator category tags
 ** iterator, iterator_traits
+** iterator_category, distance, advance
 ** reverse_iterator
 ** random_access_iterator
+** is_contiguous_iterator, to_address
 */
 
-# include <cstddef> // ptrdiff_t
+# include <cstddef>   // ptrdiff_t
+# include <iterator>  // std::*_iterator_tag
+# include "type_traits.hpp"
 
 namespace ft {
   /* ============================================================ */
@@ -19,6 +23,7 @@ namespace ft {
   class forward_iterator_tag       : public input_iterator_tag         {};  // 전진만 가능, 한 번에 여러 개 읽고 쓰기 가능
   class bidirectional_iterator_tag : public forward_iterator_tag       {};  // 전/후진 모두 가능, 한 번에 여러 개 읽고 쓰기 가능
   class random_access_iterator_tag : public bidirectional_iterator_tag {};  // 반복자를 임의의 위치만큼 전/후진 가능
+  class contiguous_iterator_tag    : public random_access_iterator_tag {};  // random access에 더해 element가 메모리에 연속으로 놓임
 
 
   /* ============================================================ */
@@ -68,6 +73,69 @@ namespace ft {
     typedef random_access_iterator_tag  iterator_category;
   };
 
+  /* ============================================================ */
+  /*                      iterator_category                       */
+  /* ============================================================ */
+
+  /*
+  ** std의 iterator(std::istream_iterator 등)는 std의 category tag를 사용하므로
+  ** ft의 tag로 바꿔서 ft의 tag 하나로 tag dispatch를 할 수 있게 한다.
+  */
+  template <class Category> struct iterator_category_convert { typedef Category type; };
+  template<> struct iterator_category_convert<std::input_iterator_tag> { typedef input_iterator_tag type; };
+  template<> struct iterator_category_convert<std::output_iterator_tag> { typedef output_iterator_tag type; };
+  template<> struct iterator_category_convert<std::forward_iterator_tag> { typedef forward_iterator_tag type; };
+  template<> struct iterator_category_convert<std::bidirectional_iterator_tag> { typedef bidirectional_iterator_tag type; };
+  template<> struct iterator_category_convert<std::random_access_iterator_tag> { typedef random_access_iterator_tag type; };
+
+  /* iterator의 category tag 객체를 반환한다. */
+  template <class Iterator>
+  typename iterator_category_convert<typename iterator_traits<Iterator>::iterator_category>::type
+  iterator_category(const Iterator&) {
+    return (typename iterator_category_convert<typename iterator_traits<Iterator>::iterator_category>::type());
+  }
+
+  /* distance */
+  template <class InputIterator>
+  typename iterator_traits<InputIterator>::difference_type
+  distance(InputIterator first, InputIterator last, input_iterator_tag) {
+    typename iterator_traits<InputIterator>::difference_type n = 0;
+    for (; first != last; ++first)
+      n++;
+    return (n);
+  }
+  template <class RandomAccessIterator>
+  typename iterator_traits<RandomAccessIterator>::difference_type
+  distance(RandomAccessIterator first, RandomAccessIterator last, random_access_iterator_tag) {
+    return (last - first);
+  }
+  template <class InputIterator>
+  typename iterator_traits<InputIterator>::difference_type distance(InputIterator first, InputIterator last) {
+    return (ft::distance(first, last, ft::iterator_category(first)));
+  }
+
+  /* advance */
+  template <class InputIterator, class Distance>
+  void advance(InputIterator& it, Distance n, input_iterator_tag) {
+    for (; n > 0; --n)
+      ++it;
+  }
+  template <class BidirectionalIterator, class Distance>
+  void advance(BidirectionalIterator& it, Distance n, bidirectional_iterator_tag) {
+    for (; n > 0; --n)
+      ++it;
+    for (; n < 0; ++n)
+      --it;
+  }
+  template <class RandomAccessIterator, class Distance>
+  void advance(RandomAccessIterator& it, Distance n, random_access_iterator_tag) {
+    it += n;
+  }
+  template <class InputIterator, class Distance>
+  void advance(InputIterator& it, Distance n) {
+    ft::advance(it, n, ft::iterator_category(it));
+  }
+
   /* ============================================================ */
   /*                       reverse_iterator                       */
   /* ============================================================ */
@@ -166,6 +234,13 @@ namespace ft {
   /* ============================================================ */
   /*                    random_access_iterator                    */
   /* ============================================================ */
+
+  /*
+  ** vector, small_vector의 iterator
+  ** 포인터 하나만 들고 있고 가상 함수가 없어서 포인터와 크기가 같고 trivially copyable이다.
+  ** 복사 생성자, 대입 연산자, 소멸자는 컴파일러가 만든 것을 사용하므로 루프가 포인터 연산으로 최적화된다.
+  ** iterator_category는 random_access_iterator_tag이고, 연속된 메모리라는 것은 iterator_concept로 알린다.
+  */
   template <typename T>
   class random_access_iterator : public iterator<random_access_iterator_tag, T> {
     public:
@@ -174,27 +249,19 @@ namespace ft {
     typedef typename iterator<random_access_iterator_tag, T>::pointer             pointer;
     typedef typename iterator<random_access_iterator_tag, T>::reference           reference;
     typedef typename iterator<random_access_iterator_tag, T>::iterator_category   iterator_category;
+    typedef contiguous_iterator_tag                                               iterator_concept;
 
     protected:
     pointer _ptr;
 
     public:
-    random_access_iterator(void)                                 : _ptr(NULL) {}
-    random_access_iterator(pointer ptr)                          : _ptr(ptr) {}
-    random_access_iterator(const random_access_iterator<T>& ref) : _ptr(ref._ptr) {}
+    random_access_iterator(void)        : _ptr(NULL) {}
+    random_access_iterator(pointer ptr) : _ptr(ptr) {}
 
     operator random_access_iterator<const value_type>() const {
       return random_access_iterator<const value_type>(_ptr);
     }
 
-    random_access_iterator& operator=(const random_access_iterator& ref) {
-      if (this != &ref)
-        _ptr = ref._ptr;
-      return (*this);
-    }
-
-    virtual ~random_access_iterator() {}
-
     pointer base(void) const { return (_ptr); }
 
     reference operator* (void) const              { return (*_ptr); }
@@ -255,6 +322,47 @@ namespace ft {
   typename random_access_iterator<T1>::difference_type operator-(const random_access_iterator<T1>& lhs, const random_access_iterator<T2>& rhs) {
     return (lhs.base() - rhs.base());
   }
+
+  /* ============================================================ */
+  /*                    is_contiguous_iterator                    */
+  /* ============================================================ */
+
+  /* iterator_concept typedef가 있는지 식별한다. */
+  template <class Iterator>
+  struct has_iterator_concept {
+    private:
+    typedef char  yes;
+    typedef long  no;
+
+    template <class U> static yes test(typename U::iterator_concept*);
+    template <class U> static no  test(...);
+
+    public:
+    static const bool value = (sizeof(test<Iterator>(NULL)) == sizeof(yes));
+  };
+
+  template <class Iterator, bool = has_iterator_concept<Iterator>::value>
+  struct is_contiguous_iterator_helper : public false_type {};
+  template <class Iterator>
+  struct is_contiguous_iterator_helper<Iterator, true>
+    : public is_same<typename Iterator::iterator_concept, contiguous_iterator_tag> {};
+
+  /*
+  ** element가 메모리에 연속으로 놓이는 iterator인지 식별한다.
+  ** 포인터와, iterator_concept가 contiguous_iterator_tag인 iterator가 해당한다.
+  ** true인 iterator는 to_address로 가리키는 주소를 얻어 포인터로 처리할 수 있다.
+  */
+  template <class Iterator> struct is_contiguous_iterator     : public is_contiguous_iterator_helper<Iterator> {};
+  template <class T>        struct is_contiguous_iterator<T*> : public true_type {};
+
+  template <class T>
+  T* to_address(T* ptr) {
+    return (ptr);
+  }
+  template <class T>
+  T* to_address(const random_access_iterator<T>& it) {
+    return (it.base());
+  }
 }
 
 #endif
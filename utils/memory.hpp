@@ -0,0 +1,526 @@
+#ifndef MEMORY_HPP_
+# define MEMORY_HPP_
+
+/*
+** uninitialized_copy, uninitialized_fill_n, uninitialized_move_if_noexcept (C++11)
+** destroy
+** relocate, relocate_overlapping, relocate_with_gap
+** aligned_buffer
+** allocator_has_reallocate, allocator_has_usable_size, allocator_reallocate, allocator_usable_size
+** buffer_insert_fill, buffer_insert_range, buffer_emplace (C++11)
+** buffer_erase, buffer_erase_if, buffer_erase_indices, buffer_erase_unordered
+*/
+
+# include <cstddef>   // std::size_t
+# include <cstring>   // std::memcpy, std::memmove
+# include "algorithm.hpp"
+# include "type_traits.hpp"
+# if __cplusplus >= 201103L
+#  include <memory>   // std::allocator_traits
+#  include <utility>  // std::forward, std::move, std::move_if_noexcept
+# endif
+
+namespace ft {
+
+  /* ============================================================ */
+  /*                       uninitialized_*                        */
+  /* ============================================================ */
+
+  /*
+  ** [first, last)를 초기화되지 않은 메모리 dest에 allocator로 복사 생성한다.
+  ** 중간에 예외가 발생하면 이미 생성한 element를 파괴하고 예외를 다시 던진다.
+  */
+  template <class Alloc, class InputIterator, class T>
+  T* uninitialized_copy(Alloc& alloc, InputIterator first, InputIterator last, T* dest, false_type) {
+    T* cur = dest;
+    try {
+      for (; first != last; ++first, ++cur)
+        alloc.construct(cur, *first);
+    } catch (...) {
+      for (; dest != cur; ++dest)
+        alloc.destroy(dest);
+      throw ;
+    }
+    return (cur);
+  }
+  /* 연속된 메모리의 trivially copyable element는 생성자 호출 없이 memcpy로 복사한다. */
+  template <class Alloc, class ContiguousIterator, class T>
+  T* uninitialized_copy(Alloc&, ContiguousIterator first, ContiguousIterator last, T* dest, true_type) {
+    std::size_t n = static_cast<std::size_t>(last - first);
+    if (n > 0)
+      std::memcpy(dest, ft::to_address(first), n * sizeof(T));
+    return (dest + n);
+  }
+
+  template <class Alloc, class InputIterator, class T>
+  T* uninitialized_copy(Alloc& alloc, InputIterator first, InputIterator last, T* dest) {
+    return (uninitialized_copy(alloc, first, last, dest, typename is_memmovable_range_pair<InputIterator, T*>::type()));
+  }
+
+  template <class Alloc, class T>
+  T* uninitialized_fill_n(Alloc& alloc, T* dest, std::size_t n, const T& val) {
+    T* cur = dest;
+    try {
+      for (; n > 0; --n, ++cur)
+        alloc.construct(cur, val);
+    } catch (...) {
+      for (; dest != cur; ++dest)
+        alloc.destroy(dest);
+      throw ;
+    }
+    return (cur);
+  }
+
+# if __cplusplus >= 201103L
+  /*
+  ** [first, last)를 초기화되지 않은 메모리 dest로 이동 생성한다.
+  ** 이동 생성자가 예외를 던질 수 있는 타입은 복사 생성해서, 중간에 예외가 발생해도 원본이 그대로 남도록 한다.
+  */
+  template <class Alloc, class T>
+  T* uninitialized_move_if_noexcept(Alloc& alloc, T* first, T* last, T* dest) {
+    T* cur = dest;
+    try {
+      for (; first != last; ++first, ++cur)
+        std::allocator_traits<Alloc>::construct(alloc, cur, std::move_if_noexcept(*first));
+    } catch (...) {
+      for (; dest != cur; ++dest)
+        alloc.destroy(dest);
+      throw ;
+    }
+    return (cur);
+  }
+# endif
+
+  /* ============================================================ */
+  /*                           destroy                            */
+  /* ============================================================ */
+
+  template <class Alloc, class T>
+  void destroy(Alloc&, T*, T*, true_type) {}
+  template <class Alloc, class T>
+  void destroy(Alloc& alloc, T* first, T* last, false_type) {
+    for (; first != last; ++first)
+      alloc.destroy(first);
+  }
+
+  /*
+  ** [first, last)의 element를 파괴한다.
+  ** trivially copyable한 타입은 소멸자가 하는 일이 없으므로 루프 자체를 생략한다.
+  */
+  template <class Alloc, class T>
+  void destroy(Alloc& alloc, T* first, T* last) {
+    destroy(alloc, first, last, typename is_trivially_copyable<T>::type());
+  }
+
+  /* ============================================================ */
+  /*                           relocate                           */
+  /* ============================================================ */
+
+  template <class Alloc, class T>
+  T* relocate(Alloc&, T* first, T* last, T* dest, true_type) {
+    if (first != last)
+      std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), (last - first) * sizeof(T));
+    return (dest + (last - first));
+  }
+  template <class Alloc, class T>
+  T* relocate(Alloc& alloc, T* first, T* last, T* dest, false_type) {
+# if __cplusplus >= 201103L
+    T* rtn = uninitialized_move_if_noexcept(alloc, first, last, dest);
+# else
+    T* rtn = uninitialized_copy(alloc, first, last, dest);
+# endif
+    destroy(alloc, first, last);
+    return (rtn);
+  }
+
+  /*
+  ** Relocate elements
+  ** [first, last)의 element를 겹치지 않는 초기화되지 않은 메모리 dest로 옮기고, 원본은 초기화되지 않은 상태가 된다.
+  ** trivially relocatable한 타입은 memcpy 한 번으로 버퍼 전체를 옮기고,
+  ** 그 외의 타입은 dest에 복사 생성한 뒤 원본을 파괴한다. 복사 중 예외가 발생하면 원본은 그대로 남는다.
+  ** C++11 이상에서는 이동 생성자가 noexcept인 타입은 복사 대신 이동 생성한다.
+  */
+  template <class Alloc, class T>
+  T* relocate(Alloc& alloc, T* first, T* last, T* dest) {
+    return (relocate(alloc, first, last, dest, typename is_trivially_relocatable<T>::type()));
+  }
+
+  /*
+  ** [first, last)를 dest로 memmove 한다. 두 범위가 겹쳐도 된다.
+  ** trivially relocatable한 타입에만 사용해야 하며, 원본 중 dest 범위와 겹치지 않는 부분은 초기화되지 않은 상태로 본다.
+  */
+  template <class T>
+  void relocate_overlapping(T* first, T* last, T* dest) {
+    if (first != last && first != dest)
+      std::memmove(static_cast<void*>(dest), static_cast<const void*>(first), (last - first) * sizeof(T));
+  }
+
+  /*
+  ** [first, last)를 겹치지 않는 초기화되지 않은 메모리 dest로 옮기면서 pos 위치에 n칸의 빈자리를 남긴다.
+  ** [first, pos)는 dest로, [pos, last)는 dest + (pos - first) + n으로 옮겨진다.
+  ** trivially relocatable하지 않은 타입은 모두 복사한 뒤에 원본을 파괴하므로
+  ** 복사 중 예외가 발생하면 dest에 생성한 element만 정리되고 원본은 그대로 남는다.
+  */
+  template <class Alloc, class T>
+  void relocate_with_gap(Alloc& alloc, T* first, T* pos, T* last, T* dest, std::size_t n) {
+    if (is_trivially_relocatable<T>::value) {
+      relocate(alloc, first, pos, dest);
+      relocate(alloc, pos, last, dest + (pos - first) + n);
+      return ;
+    }
+# if __cplusplus >= 201103L
+    T* dest_pos = uninitialized_move_if_noexcept(alloc, first, pos, dest);
+    try {
+      uninitialized_move_if_noexcept(alloc, pos, last, dest_pos + n);
+# else
+    T* dest_pos = uninitialized_copy(alloc, first, pos, dest);
+    try {
+      uninitialized_copy(alloc, pos, last, dest_pos + n);
+# endif
+    } catch (...) {
+      destroy(alloc, dest, dest_pos);
+      throw ;
+    }
+    destroy(alloc, first, last);
+  }
+
+  /* ============================================================ */
+  /*                     allocator extensions                     */
+  /* ============================================================ */
+
+  /*
+  ** allocator가 reallocate(pointer, size_type, size_type)와 usable_size(pointer, size_type) const를
+  ** 제공하는지 식별한다. 두 함수의 의미는 utils/allocator.hpp의 Reallocation protocol을 따른다.
+  */
+  template <class Alloc>
+  struct allocator_has_reallocate_helper {
+    typedef char  yes;
+    struct        no { char c[2]; };
+    template <class U, typename U::pointer (U::*)(typename U::pointer, typename U::size_type, typename U::size_type)>
+    struct check {};
+    template <class U> static yes test(check<U, &U::reallocate>*);
+    template <class U> static no  test(...);
+    static const bool value = sizeof(test<Alloc>(0)) == sizeof(yes);
+  };
+  template <class Alloc>
+  struct allocator_has_reallocate
+    : public integral_constant<bool, allocator_has_reallocate_helper<Alloc>::value> {};
+
+  template <class Alloc>
+  struct allocator_has_usable_size_helper {
+    typedef char  yes;
+    struct        no { char c[2]; };
+    template <class U, typename U::size_type (U::*)(typename U::pointer, typename U::size_type) const>
+    struct check {};
+    template <class U> static yes test(check<U, &U::usable_size>*);
+    template <class U> static no  test(...);
+    static const bool value = sizeof(test<Alloc>(0)) == sizeof(yes);
+  };
+  template <class Alloc>
+  struct allocator_has_usable_size
+    : public integral_constant<bool, allocator_has_usable_size_helper<Alloc>::value> {};
+
+  template <class Alloc>
+  typename Alloc::pointer allocator_reallocate(Alloc& alloc, typename Alloc::pointer p,
+    typename Alloc::size_type old_n, typename Alloc::size_type new_n, typename Alloc::size_type, true_type) {
+      return (alloc.reallocate(p, old_n, new_n));
+    }
+  template <class Alloc>
+  typename Alloc::pointer allocator_reallocate(Alloc& alloc, typename Alloc::pointer p,
+    typename Alloc::size_type old_n, typename Alloc::size_type new_n, typename Alloc::size_type size, false_type) {
+      typename Alloc::pointer q = alloc.allocate(new_n);
+      relocate(alloc, p, p + size, q);
+      alloc.deallocate(p, old_n);
+      return (q);
+    }
+
+  /*
+  ** old_n개로 할당한 block p를 new_n개 크기의 block으로 바꾸고, 앞쪽 size개의 element를 그대로 옮긴다.
+  ** allocator에 reallocate가 있으면 제자리에서 늘어날 수 있고, 없으면 새로 할당해서 옮긴다.
+  ** reallocate는 byte 단위로 옮기므로 trivially relocatable한 element에만 사용해야 한다.
+  */
+  template <class Alloc>
+  typename Alloc::pointer allocator_reallocate(Alloc& alloc, typename Alloc::pointer p,
+    typename Alloc::size_type old_n, typename Alloc::size_type new_n, typename Alloc::size_type size) {
+      return (allocator_reallocate(alloc, p, old_n, new_n, size, typename allocator_has_reallocate<Alloc>::type()));
+    }
+
+  template <class Alloc>
+  typename Alloc::size_type allocator_usable_size(const Alloc& alloc, typename Alloc::pointer p,
+    typename Alloc::size_type n, true_type) {
+      return (alloc.usable_size(p, n));
+    }
+  template <class Alloc>
+  typename Alloc::size_type allocator_usable_size(const Alloc&, typename Alloc::pointer,
+    typename Alloc::size_type n, false_type) {
+      return (n);
+    }
+
+  /* n개로 할당한 block p의 실제 capacity를 반환한다. allocator에 usable_size가 없으면 n이다. */
+  template <class Alloc>
+  typename Alloc::size_type allocator_usable_size(const Alloc& alloc, typename Alloc::pointer p,
+    typename Alloc::size_type n) {
+      return (allocator_usable_size(alloc, p, n, typename allocator_has_usable_size<Alloc>::type()));
+    }
+
+  /* ============================================================ */
+  /*                        aligned_buffer                        */
+  /* ============================================================ */
+
+  /*
+  ** T를 N개 담을 수 있는 초기화되지 않은 저장 공간이다.
+  ** C++98에는 alignas가 없으므로 기본 타입들과 union으로 묶어 기본 타입 중 가장 큰 정렬을 맞춘다.
+  */
+  template <class T, std::size_t N>
+  union aligned_buffer {
+    char          _bytes[sizeof(T) * (N > 0 ? N : 1)];
+    long double   _align_long_double;
+    double        _align_double;
+    long          _align_long;
+    void*         _align_pointer;
+    void          (*_align_function)();
+  };
+
+  /* ============================================================ */
+  /*                      buffer operations                       */
+  /* ============================================================ */
+
+  /*
+  ** ft::vector와 ft::small_vector가 공유하는 연속 버퍼 연산이다.
+  ** [ptr, ptr + size)가 살아있는 element이고, 삽입 연산은 capacity가 충분하다고 가정한다.
+  ** size는 element가 실제로 생성되거나 파괴될 때마다 갱신되어 예외가 발생해도 버퍼와 일치한다.
+  */
+
+  template <class T>
+  T* compact_block(T* first, T* last, T* out, true_type) {
+    relocate_overlapping(first, last, out);
+    return (out + (last - first));
+  }
+  template <class T>
+  T* compact_block(T* first, T* last, T* out, false_type) {
+    return (ft::copy(first, last, out));
+  }
+
+  /*
+  ** 남길 element 구간 [first, last)를 앞쪽 out으로 당기고 다음에 쓸 위치를 반환한다.
+  ** trivially relocatable한 타입은 memmove로, 그 외의 타입은 대입으로 옮긴다.
+  */
+  template <class T>
+  T* compact_block(T* first, T* last, T* out) {
+    return (compact_block(first, last, out, typename is_trivially_relocatable<T>::type()));
+  }
+
+  /*
+  ** idx 위치에 val을 n개 삽입한다.
+  ** trivially relocatable한 타입은 뒤쪽 element를 memmove 한 번으로 밀고 빈자리에 생성한다.
+  ** 그 외의 타입은 뒤에서부터 끝을 넘어가는 element는 복사 생성하고, 나머지는 대입으로 민다.
+  */
+  template <class Alloc, class T, class Size>
+  void buffer_insert_fill(Alloc& alloc, T* ptr, Size& size, Size idx, Size n, const T& val) {
+    T* pos = ptr + idx;
+    T* old_end = ptr + size;
+    Size after = size - idx;
+    if (is_trivially_relocatable<T>::value) {
+      relocate_overlapping(pos, old_end, pos + n);
+      try {
+        uninitialized_fill_n(alloc, pos, n, val);
+      } catch (...) {
+        relocate_overlapping(pos + n, old_end + n, pos);
+        throw ;
+      }
+      size += n;
+    } else if (after > n) {
+      uninitialized_copy(alloc, old_end - n, old_end, old_end);
+      size += n;
+      ft::copy_backward(pos, old_end - n, old_end);
+      ft::fill(pos, pos + n, val);
+    } else {
+      uninitialized_fill_n(alloc, old_end, n - after, val);
+      size += n - after;
+      uninitialized_copy(alloc, pos, old_end, pos + n);
+      size += after;
+      ft::fill(pos, old_end, val);
+    }
+  }
+
+  /* idx 위치에 길이가 n인 [first, last)를 삽입한다. 동작 방식은 buffer_insert_fill과 같다. */
+  template <class Alloc, class T, class Size, class ForwardIterator>
+  void buffer_insert_range(Alloc& alloc, T* ptr, Size& size, Size idx,
+    ForwardIterator first, ForwardIterator last, Size n) {
+      T* pos = ptr + idx;
+      T* old_end = ptr + size;
+      Size after = size - idx;
+      if (is_trivially_relocatable<T>::value) {
+        relocate_overlapping(pos, old_end, pos + n);
+        try {
+          uninitialized_copy(alloc, first, last, pos);
+        } catch (...) {
+          relocate_overlapping(pos + n, old_end + n, pos);
+          throw ;
+        }
+        size += n;
+      } else if (after > n) {
+        uninitialized_copy(alloc, old_end - n, old_end, old_end);
+        size += n;
+        ft::copy_backward(pos, old_end - n, old_end);
+        ft::copy(first, last, pos);
+      } else {
+        ForwardIterator mid = first;
+        for (Size i = 0; i < after; i++)
+          ++mid;
+        uninitialized_copy(alloc, mid, last, old_end);
+        size += n - after;
+        uninitialized_copy(alloc, pos, old_end, pos + n);
+        size += after;
+        ft::copy(first, mid, pos);
+      }
+    }
+
+# if __cplusplus >= 201103L
+  /*
+  ** idx 위치에 args로 element 하나를 생성한다.
+  ** args가 버퍼 안의 element를 참조할 수 있으므로 중간에 삽입할 때는 임시 객체를 먼저 만든다.
+  ** trivially relocatable한 타입은 뒤쪽 element를 memmove로 밀고, 그 외의 타입은 이동 대입으로 민다.
+  */
+  template <class Alloc, class T, class Size, class... Args>
+  void buffer_emplace(Alloc& alloc, T* ptr, Size& size, Size idx, Args&&... args) {
+    T* pos = ptr + idx;
+    T* old_end = ptr + size;
+    if (idx == size) {
+      std::allocator_traits<Alloc>::construct(alloc, pos, std::forward<Args>(args)...);
+    } else if (is_trivially_relocatable<T>::value) {
+      T tmp(std::forward<Args>(args)...);
+      relocate_overlapping(pos, old_end, pos + 1);
+      std::allocator_traits<Alloc>::construct(alloc, pos, std::move(tmp));
+    } else {
+      T tmp(std::forward<Args>(args)...);
+      std::allocator_traits<Alloc>::construct(alloc, old_end, std::move(*(old_end - 1)));
+      size++;
+      for (T* cur = old_end - 1; cur != pos; --cur)
+        *cur = std::move(*(cur - 1));
+      *pos = std::move(tmp);
+      return ;
+    }
+    size++;
+  }
+# endif
+
+  /*
+  ** [idx, idx + n)의 element를 제거하고 뒤쪽 element를 앞으로 당긴다.
+  ** trivially relocatable한 타입은 제거할 element를 파괴한 뒤 memmove 한 번으로 당기고,
+  ** 그 외의 타입은 대입으로 당긴 뒤 남은 꼬리 n개를 한꺼번에 파괴한다.
+  */
+  template <class Alloc, class T, class Size>
+  void buffer_erase(Alloc& alloc, T* ptr, Size& size, Size idx, Size n) {
+    T* pos = ptr + idx;
+    T* old_end = ptr + size;
+    if (is_trivially_relocatable<T>::value) {
+      destroy(alloc, pos, pos + n);
+      relocate_overlapping(pos + n, old_end, pos);
+    } else {
+      ft::copy(pos + n, old_end, pos);
+      destroy(alloc, old_end - n, old_end);
+    }
+    size -= n;
+  }
+
+  /*
+  ** pred가 true를 반환하는 element를 모두 제거하고, 제거한 element의 수를 반환한다.
+  ** 남는 element의 순서는 유지되고, 버퍼를 한 번만 순회하며 pred는 element마다 한 번씩 호출된다.
+  */
+  template <class Alloc, class T, class Size, class Predicate>
+  Size buffer_erase_if(Alloc& alloc, T* ptr, Size& size, Predicate pred) {
+    T* last = ptr + size;
+    T* cur = ptr;
+    while (cur != last && !pred(*cur))
+      cur++;
+    if (cur == last) return (0);
+    T* out = cur;
+    if (is_trivially_relocatable<T>::value) {
+      // 제거할 element는 바로 파괴하고, 남길 element는 연속된 구간 단위로 memmove 한다.
+      T* run = cur;
+      try {
+        while (cur != last) {
+          destroy(alloc, cur, cur + 1);
+          run = ++cur;
+          while (cur != last && !pred(*cur))
+            cur++;
+          relocate_overlapping(run, cur, out);
+          out += cur - run;
+        }
+      } catch (...) {
+        relocate_overlapping(run, last, out);
+        size -= run - out;
+        throw ;
+      }
+    } else {
+      try {
+        for (++cur; cur != last; cur++) {
+          if (!pred(*cur))
+            *out++ = *cur;
+        }
+      } catch (...) {
+        out = ft::copy(cur, last, out);
+        destroy(alloc, out, last);
+        size = out - ptr;
+        throw ;
+      }
+      destroy(alloc, out, last);
+    }
+    Size removed = last - out;
+    size -= removed;
+    return (removed);
+  }
+
+  /*
+  ** 오름차순으로 정렬된 index 범위 [first, last)의 element를 제거하고, 제거한 element의 수를 반환한다.
+  ** 중복된 index는 한 번만 제거한다. 남는 element의 순서는 유지되고, 버퍼를 한 번만 순회한다.
+  */
+  template <class Alloc, class T, class Size, class InputIterator>
+  Size buffer_erase_indices(Alloc& alloc, T* ptr, Size& size, InputIterator first, InputIterator last) {
+    if (first == last) return (0);
+    const bool relocatable = is_trivially_relocatable<T>::value;
+    T* old_end = ptr + size;
+    Size prev = *first;
+    T* out = ptr + prev;
+    if (relocatable)
+      destroy(alloc, out, out + 1);
+    for (++first; first != last; ++first) {
+      Size idx = *first;
+      if (idx == prev) continue;
+      if (relocatable)
+        destroy(alloc, ptr + idx, ptr + idx + 1);
+      out = compact_block(ptr + prev + 1, ptr + idx, out);
+      prev = idx;
+    }
+    out = compact_block(ptr + prev + 1, old_end, out);
+    if (!relocatable)
+      destroy(alloc, out, old_end);
+    Size removed = old_end - out;
+    size -= removed;
+    return (removed);
+  }
+
+  /*
+  ** idx의 element를 마지막 element로 덮어쓰고 마지막 element를 제거한다.
+  ** O(1)이지만 element의 순서가 바뀐다.
+  */
+  template <class Alloc, class T, class Size>
+  void buffer_erase_unordered(Alloc& alloc, T* ptr, Size& size, Size idx) {
+    T* pos = ptr + idx;
+    T* back = ptr + (size - 1);
+    if (pos != back) {
+      if (is_trivially_relocatable<T>::value) {
+        destroy(alloc, pos, pos + 1);
+        relocate(alloc, back, back + 1, pos);
+        size--;
+        return ;
+      }
+      *pos = *back;
+    }
+    alloc.destroy(back);
+    size--;
+  }
+}
+
+#endif
@@ -0,0 +1,245 @@
+#ifndef NODE_POOL_HPP_
+# define NODE_POOL_HPP_
+
+/*
+** node_pool
+** 크기가 같은 node를 큰 chunk 단위로 할당해 두고 하나씩 나눠주는 pool이다.
+** 반환된 node는 free list에 넣어 다음 할당에 다시 사용한다.
+** rbtree가 node를 할당할 때 사용하며, 같은 node 타입의 여러 tree가 pool 하나를 공유할 수 있다.
+** 할당과 반환은 동기화하지 않으므로 pool을 공유하는 tree들은 같은 thread에서만 사용해야 한다.
+** 빈 node 자리에 포인터를 저장하므로 Node는 포인터 두 개 이상의 크기여야 한다.
+**
+** tree 사이에서 node를 옮기면(split, join) 받는 쪽 pool이 보내는 쪽 pool을 adopt한다.
+** 옮겨진 node는 받는 쪽 pool의 free list로 반환되고, 보내는 쪽 pool의 chunk는 adopt한 pool이 모두 놓을 때까지 해제되지 않는다.
+** 이때 참조 수만 mutex로 보호하므로, 두 pool을 각자 다른 thread의 tree가 계속 사용할 수 있다.
+*/
+
+# include <cstddef>   // std::size_t
+# include <memory>    // std::allocator
+# include <pthread.h> // pthread_mutex_t
+
+namespace ft {
+  template < class Node, class Alloc = std::allocator<Node> >
+  class node_pool {
+    public:
+    typedef Node            node_type;
+    typedef Node*           pointer;
+    typedef Alloc           allocator_type;
+    typedef std::size_t     size_type;
+
+    static const size_type  min_chunk_nodes = 16;
+    static const size_type  default_max_chunk_nodes = 1024;
+
+    private:
+    /* 반환된 node 자리에 다음 free node의 주소를 저장한다. */
+    struct free_node {
+      free_node*  next;
+    };
+    /* chunk의 첫 번째 node 자리에 이전 chunk와 이 chunk의 node 수를 저장한다. */
+    struct chunk_header {
+      pointer     next;
+      size_type   nodes;
+    };
+    /* 이 pool이 node를 넘겨받아서 chunk를 살려두고 있는 다른 pool */
+    struct adoption {
+      node_pool*  pool;
+      adoption*   next;
+    };
+
+    allocator_type  _alloc;
+    pointer         _chunks;            // 가장 최근에 할당한 chunk
+    pointer         _cur;               // 현재 chunk에서 아직 나눠주지 않은 첫 번째 node
+    pointer         _last;              // 현재 chunk의 끝
+    free_node*      _free;
+    size_type       _chunk_nodes;       // 다음에 할당할 chunk의 node 수
+    size_type       _max_chunk_nodes;
+    size_type       _capacity;          // chunk들이 담을 수 있는 node의 수
+    size_type       _in_use;            // 나눠준 뒤 아직 반환되지 않은 node의 수
+    adoption*       _adopted;
+    size_type       _refs;              // 소유자(1)와 이 pool을 adopt한 pool의 수
+    pthread_mutex_t _refs_mutex;
+
+    node_pool(const node_pool&);
+    node_pool& operator=(const node_pool&);
+
+    public:
+    /*
+    ** chunk는 min_chunk_nodes개부터 시작해 max_chunk_nodes개까지 두 배씩 커진다.
+    ** 작은 tree는 메모리를 적게 쓰고, 큰 tree는 인접한 node가 같은 chunk에 모인다.
+    */
+    explicit node_pool(size_type max_chunk_nodes = default_max_chunk_nodes, const allocator_type& alloc = allocator_type())
+      : _alloc(alloc), _chunks(NULL), _cur(NULL), _last(NULL), _free(NULL),
+        _chunk_nodes(min_chunk_nodes), _max_chunk_nodes(max_chunk_nodes < min_chunk_nodes ? min_chunk_nodes : max_chunk_nodes),
+        _capacity(0), _in_use(0), _adopted(NULL), _refs(1) {
+        pthread_mutex_init(&_refs_mutex, NULL);
+      }
+    ~node_pool() {
+      drop_adopted();
+      free_chunks();
+      pthread_mutex_destroy(&_refs_mutex);
+    }
+
+    /* 생성자를 호출하지 않은 node 하나의 메모리를 반환한다. */
+    pointer allocate() {
+      pointer ptr;
+      if (_free != NULL) {
+        ptr = reinterpret_cast<pointer>(_free);
+        _free = _free->next;
+      } else {
+        if (_cur == _last)
+          refill(_chunk_nodes);
+        ptr = _cur++;
+      }
+      _in_use++;
+      return (ptr);
+    }
+
+    /* 소멸자를 호출한 node의 메모리를 free list에 넣는다. */
+    void deallocate(pointer ptr) {
+      free_node* node = reinterpret_cast<free_node*>(ptr);
+      node->next = _free;
+      _free = node;
+      _in_use--;
+    }
+
+    /*
+    ** 빈 node를 모두 버리고 adopt한 pool을 놓은 뒤 chunk를 해제한다.
+    ** 다른 pool이 이 pool을 adopt해서 chunk 안의 node를 쓰고 있으면 chunk는 그 pool이 놓을 때까지 남겨둔다.
+    ** 나눠준 node가 모두 반환된 뒤에만 호출해야 한다.
+    */
+    void release() {
+      drop_adopted();
+      _cur = NULL;
+      _last = NULL;
+      _free = NULL;
+      _chunk_nodes = min_chunk_nodes;
+      _capacity = 0;
+      if (!lent())
+        free_chunks();
+    }
+
+    /*
+    ** from의 chunk에 있는 node nodes개가 이 pool을 쓰는 tree로 옮겨 왔음을 기록한다.
+    ** from과, from이 adopt한 pool들의 chunk를 이 pool이 놓을 때까지 살려둔다.
+    ** from은 new로 만들어 remove_ref로 해제하는 pool이어야 한다.
+    */
+    void adopt(node_pool& from, size_type nodes) {
+      if (&from == this)
+        return ;
+      hold(&from);
+      for (adoption* it = from._adopted; it != NULL; it = it->next) {
+        if (it->pool != this)
+          hold(it->pool);
+      }
+      from._in_use -= nodes;
+      from._capacity -= nodes;
+      _in_use += nodes;
+      _capacity += nodes;
+    }
+
+    void add_ref() {
+      pthread_mutex_lock(&_refs_mutex);
+      ++_refs;
+      pthread_mutex_unlock(&_refs_mutex);
+    }
+
+    /* 참조를 하나 놓고, 남은 참조가 없으면 true를 반환한다. 그때 호출한 쪽이 pool을 delete한다. */
+    bool remove_ref() {
+      pthread_mutex_lock(&_refs_mutex);
+      bool last = (--_refs == 0);
+      pthread_mutex_unlock(&_refs_mutex);
+      return (last);
+    }
+
+    /* 다른 pool이 이 pool의 node를 가지고 있을 수 있는지 여부 */
+    bool lent() {
+      pthread_mutex_lock(&_refs_mutex);
+      bool result = (_refs > 1);
+      pthread_mutex_unlock(&_refs_mutex);
+      return (result);
+    }
+
+    /*
+    ** 새 chunk를 할당하지 않고 n개를 나눠줄 수 있게 한다.
+    ** 부족하면 모자란 만큼을 chunk 하나로 한 번에 할당하고, 현재 chunk의 남은 자리는 free list로 옮긴다.
+    */
+    void reserve(size_type n) {
+      size_type available = _capacity - _in_use;
+      if (available >= n)
+        return ;
+      for (; _cur != _last; ++_cur) {
+        free_node* node = reinterpret_cast<free_node*>(_cur);
+        node->next = _free;
+        _free = node;
+      }
+      refill(n - available + 1);
+    }
+
+    size_type in_use() const {
+      return (_in_use);
+    }
+
+    size_type capacity() const {
+      return (_capacity);
+    }
+
+    allocator_type get_allocator() const {
+      return (_alloc);
+    }
+
+    private:
+    /* 이미 잡고 있지 않은 pool이면 참조를 하나 더한다. */
+    void hold(node_pool* pool) {
+      for (adoption* it = _adopted; it != NULL; it = it->next) {
+        if (it->pool == pool)
+          return ;
+      }
+      adoption* entry = new adoption;
+      entry->pool = pool;
+      entry->next = _adopted;
+      _adopted = entry;
+      pool->add_ref();
+    }
+
+    /* adopt한 pool을 모두 놓는다. free list에 그 pool의 node가 있을 수 있으므로 free list를 버린 뒤에만 다시 할당할 수 있다. */
+    void drop_adopted() {
+      while (_adopted != NULL) {
+        adoption* entry = _adopted;
+        _adopted = entry->next;
+        if (entry->pool->remove_ref())
+          delete entry->pool;
+        delete entry;
+      }
+    }
+
+    void free_chunks() {
+      while (_chunks != NULL) {
+        chunk_header* header = reinterpret_cast<chunk_header*>(_chunks);
+        pointer next = header->next;
+        _alloc.deallocate(_chunks, header->nodes);
+        _chunks = next;
+      }
+    }
+
+    /* node가 nodes개인 chunk를 할당한다. 첫 번째 node 자리는 chunk_header로 사용한다. */
+    void refill(size_type nodes) {
+      pointer chunk = _alloc.allocate(nodes);
+      chunk_header* header = reinterpret_cast<chunk_header*>(chunk);
+      header->next = _chunks;
+      header->nodes = nodes;
+      _chunks = chunk;
+      _cur = chunk + 1;
+      _last = chunk + nodes;
+      _capacity += nodes - 1;
+      if (_chunk_nodes < _max_chunk_nodes)
+        _chunk_nodes = (_chunk_nodes * 2 > _max_chunk_nodes) ? _max_chunk_nodes : _chunk_nodes * 2;
+    }
+  };
+
+  template <class Node, class Alloc>
+  const typename node_pool<Node, Alloc>::size_type node_pool<Node, Alloc>::min_chunk_nodes;
+  template <class Node, class Alloc>
+  const typename node_pool<Node, Alloc>::size_type node_pool<Node, Alloc>::default_max_chunk_nodes;
+}
+
+#endif
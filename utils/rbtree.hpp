@@ -3,11 +3,16 @@
 
 /*
 ** NIL
-** TreeNode
+** TreeNodeBase, CompactTreeNodeBase, ThreadedTreeNodeBase, TreeNode
+** node layout policy (plain_node_layout, compact_node_layout, threaded_node_layout, tree_node_layout)
 ** tree_iterator
 ** Red-Black tree
 */
 
+# include <cstddef>   // std::size_t
+# include "algorithm.hpp"
+# include "iterator.hpp"
+# include "node_pool.hpp"
 # include "utility.hpp"
 
 namespace ft {
@@ -27,82 +32,174 @@ namespace ft {
   /* ============================================================ */
   /*                           TreeNode                           */
   /* ============================================================ */
-  template <typename T>
-  struct TreeNode {
+
+  /*
+  ** TreeNodeBase
+  ** node의 연결 정보와 색만 담는다. tree의 header(end)는 value 없이 이 타입으로 tree 안에 들어 있다.
+  ** 자식이 없는 자리는 NULL이고, NULL은 검은색으로 취급한다.
+  ** 부모와 색은 parent(), is_black() 등의 접근자로만 읽고 쓴다.
+  */
+  struct TreeNodeBase {
+    TreeNodeBase*   _parent;
+    TreeNodeBase*   _left;
+    TreeNodeBase*   _right;
+    bool            _is_black;
+
+    TreeNodeBase()
+      : _parent(ft::NIL), _left(ft::NIL), _right(ft::NIL), _is_black(bool()) {}
+
+    TreeNodeBase* parent() const              { return (_parent); }
+    void          set_parent(TreeNodeBase* p) { _parent = p; }
+    bool          is_black() const            { return (_is_black); }
+    void          set_black(bool black)       { _is_black = black; }
+  };
+
+  /*
+  ** CompactTreeNodeBase
+  ** node는 포인터 크기로 정렬되므로 부모 포인터의 최하위 bit는 항상 0이다.
+  ** 그 bit에 색(1이면 검은색)을 저장해서 bool과 padding만큼 node를 줄인다.
+  */
+  struct CompactTreeNodeBase {
+    std::size_t             _parent_color;
+    CompactTreeNodeBase*    _left;
+    CompactTreeNodeBase*    _right;
+
+    CompactTreeNodeBase()
+      : _parent_color(0), _left(ft::NIL), _right(ft::NIL) {}
+
+    CompactTreeNodeBase* parent() const {
+      return (reinterpret_cast<CompactTreeNodeBase*>(_parent_color & ~static_cast<std::size_t>(1)));
+    }
+    void set_parent(CompactTreeNodeBase* p) {
+      _parent_color = reinterpret_cast<std::size_t>(p) | (_parent_color & 1);
+    }
+    bool is_black() const {
+      return (_parent_color & 1);
+    }
+    void set_black(bool black) {
+      _parent_color = (_parent_color & ~static_cast<std::size_t>(1)) | static_cast<std::size_t>(black);
+    }
+  };
+
+  /*
+  ** ThreadedTreeNodeBase
+  ** CompactTreeNodeBase에 중위 순회 기준 이전 node(_prev)와 다음 node(_next)를 더한다.
+  ** header를 포함한 원형 리스트이므로 header의 _next는 가장 작은 node, _prev는 가장 큰 node이다.
+  ** iterator의 ++, --가 부모와 자식을 따라가지 않고 포인터 하나만 읽는다.
+  */
+  struct ThreadedTreeNodeBase {
+    std::size_t             _parent_color;
+    ThreadedTreeNodeBase*   _left;
+    ThreadedTreeNodeBase*   _right;
+    ThreadedTreeNodeBase*   _prev;
+    ThreadedTreeNodeBase*   _next;
+
+    ThreadedTreeNodeBase()
+      : _parent_color(0), _left(ft::NIL), _right(ft::NIL), _prev(ft::NIL), _next(ft::NIL) {}
+
+    ThreadedTreeNodeBase* parent() const {
+      return (reinterpret_cast<ThreadedTreeNodeBase*>(_parent_color & ~static_cast<std::size_t>(1)));
+    }
+    void set_parent(ThreadedTreeNodeBase* p) {
+      _parent_color = reinterpret_cast<std::size_t>(p) | (_parent_color & 1);
+    }
+    bool is_black() const {
+      return (_parent_color & 1);
+    }
+    void set_black(bool black) {
+      _parent_color = (_parent_color & ~static_cast<std::size_t>(1)) | static_cast<std::size_t>(black);
+    }
+  };
+
+  /*
+  ** node layout policy
+  ** plain_node_layout은 색을 bool로, compact_node_layout은 부모 포인터의 bit로 저장한다.
+  ** threaded_node_layout은 compact_node_layout에 이전/다음 node 링크를 더한다(threaded가 true_type).
+  ** tree_node_layout을 value_type에 대해 특수화하면 그 value_type을 담는 tree의 layout을 바꿀 수 있다.
+  */
+  struct plain_node_layout    { typedef TreeNodeBase          base_type;  typedef false_type  threaded; };
+  struct compact_node_layout  { typedef CompactTreeNodeBase   base_type;  typedef false_type  threaded; };
+  struct threaded_node_layout { typedef ThreadedTreeNodeBase  base_type;  typedef true_type   threaded; };
+
+  template <class T>
+  struct tree_node_layout { typedef compact_node_layout type; };
+
+  /* TreeNode: layout의 base에 value를 더한 실제 element node */
+  template <typename T, class Base = CompactTreeNodeBase>
+  struct TreeNode : public Base {
     typedef T     value_type;
+    typedef Base  base_type;
 
-    TreeNode*   _parent;
-    TreeNode*   _left;
-    TreeNode*   _right;
     value_type  _value;
-    bool        _is_black;
 
-    TreeNode()
-      : _parent(ft::NIL), _left(ft::NIL), _right(ft::NIL), _value(value_type()), _is_black(bool()) {}
     TreeNode(const value_type& value)
-      : _parent(ft::NIL), _left(ft::NIL), _right(ft::NIL), _value(value), _is_black(bool()) {}
+      : Base(), _value(value) {}
     TreeNode(const TreeNode& ref)
-      : _parent(ref._parent), _left(ref._left), _right(ref._right), _value(ref._value), _is_black(ref._is_black) {}
+      : Base(ref), _value(ref._value) {}
     ~TreeNode() {}
 
-    TreeNode& operator=(const TreeNode& ref) {
-      if (this != &ref) {
-        _parent = ref._parent;
-        _left = ref._left;
-        _right = ref._right;
-        _value = ref._value;
-        _is_black = ref._is_black;
-      }
-      return (*this);
-    }
+    private:
+    TreeNode& operator=(const TreeNode& ref);
   };
 
   template <typename NodePtr>
-  bool is_left_child(const NodePtr& ptr) {
-    return (ptr == ptr->_parent->_left);
+  bool is_left_child(const NodePtr ptr) {
+    return (ptr == ptr->parent()->_left);
   }
   template <typename NodePtr>
-  bool is_right_child(const NodePtr& ptr) {
-    return (ptr == ptr->_parent->_right);
+  bool is_right_child(const NodePtr ptr) {
+    return (ptr == ptr->parent()->_right);
   }
 
   template <typename NodePtr>
-  bool is_black_color(const NodePtr& ptr) {
-    return (ptr->_is_black);
+  bool is_black_color(const NodePtr ptr) {
+    return (ptr == NULL || ptr->is_black());
   }
   template <typename NodePtr>
-  bool is_red_color(const NodePtr& ptr) {
-    return (!ptr->_is_black);
+  bool is_red_color(const NodePtr ptr) {
+    return (ptr != NULL && !ptr->is_black());
   }
 
   template <typename NodePtr>
-  NodePtr get_min_node(NodePtr ptr, NodePtr nil) {
-    while (ptr->_left != nil)
+  NodePtr get_min_node(NodePtr ptr) {
+    while (ptr->_left != NULL)
       ptr = ptr->_left;
     return (ptr);
   }
   template <typename NodePtr>
-  NodePtr get_max_node(NodePtr ptr, NodePtr nil) {
-    while (ptr->_right != nil)
+  NodePtr get_max_node(NodePtr ptr) {
+    while (ptr->_right != NULL)
       ptr = ptr->_right;
     return (ptr);
   }
 
+  /*
+  ** 루트는 header의 왼쪽 자식이므로, 가장 큰 node의 다음 node는 header(end)가 되고
+  ** header의 이전 node는 가장 큰 node가 된다.
+  */
   template <typename NodePtr>
-  NodePtr get_next_node(NodePtr ptr, NodePtr nil) {
-    if (ptr->_right != nil)
-      return (get_min_node(ptr->_right, nil));
+  NodePtr get_next_node(NodePtr ptr) {
+    if (ptr->_right != NULL)
+      return (get_min_node(ptr->_right));
     while (!is_left_child(ptr))
-      ptr = ptr->_parent;
-    return (ptr->_parent);
+      ptr = ptr->parent();
+    return (ptr->parent());
   }
   template <typename NodePtr>
-  NodePtr get_prev_node(NodePtr ptr, NodePtr nil) {
-    if (ptr->_left != nil)
-      return (get_max_node(ptr->_left, nil));
+  NodePtr get_prev_node(NodePtr ptr) {
+    if (ptr->_left != NULL)
+      return (get_max_node(ptr->_left));
     while (!is_right_child(ptr))
-      ptr = ptr->_parent;
-    return (ptr->_parent);
+      ptr = ptr->parent();
+    return (ptr->parent());
+  }
+
+  /* threaded node는 링크를 그대로 따라간다. */
+  inline ThreadedTreeNodeBase* get_next_node(ThreadedTreeNodeBase* ptr) {
+    return (ptr->_next);
+  }
+  inline ThreadedTreeNodeBase* get_prev_node(ThreadedTreeNodeBase* ptr) {
+    return (ptr->_prev);
   }
 
   template <typename U, typename V, class Comp>
@@ -113,6 +210,8 @@ namespace ft {
   /* ============================================================ */
   /*                         tree_iterator                        */
   /* ============================================================ */
+
+  /* node 포인터 하나만 들고 있는 iterator. end()는 tree의 header를 가리킨다. */
   template <typename U, typename V>
   class tree_iterator {
     public:
@@ -124,32 +223,22 @@ namespace ft {
     typedef typename iterator_traits<iterator_type>::value_type         node_type;
     typedef typename iterator_traits<iterator_type>::pointer            node_pointer;
     typedef typename iterator_traits<iterator_type>::reference          node_reference;
-    typedef typename iterator_traits<iterator_type>::iterator_category  iterator_category;
+    typedef typename node_type::base_type*                              base_pointer;
+    typedef ft::bidirectional_iterator_tag                              iterator_category;
 
     private:
-    node_pointer  _current;
-    node_pointer  _nil;
+    base_pointer  _current;
 
     public:
-    tree_iterator() : _current(ft::NIL), _nil(ft::NIL) {}
-    tree_iterator(node_pointer cur, node_pointer nil) : _current(cur), _nil(nil) {}
-    tree_iterator(const tree_iterator& ref) : _current(ref._current), _nil(ref._nil) {}
-    ~tree_iterator() {}
-
-    tree_iterator& operator=(const tree_iterator& ref) {
-      if (this != &ref) {
-        _current = ref._current;
-        _nil = ref._nil;
-      }
-      return (*this);
-    }
+    tree_iterator() : _current(ft::NIL) {}
+    explicit tree_iterator(base_pointer cur) : _current(cur) {}
 
-    node_pointer base()       const { return (_current); }
-    pointer      operator->() const { return (&_current->_value); }
-    reference    operator*()  const { return (_current->_value); }
+    base_pointer base()       const { return (_current); }
+    pointer      operator->() const { return (&static_cast<node_pointer>(_current)->_value); }
+    reference    operator*()  const { return (static_cast<node_pointer>(_current)->_value); }
 
     tree_iterator& operator++() {
-      _current = get_next_node(_current, _nil);
+      _current = get_next_node(_current);
       return (*this);
     }
     tree_iterator operator++(int) {
@@ -159,7 +248,7 @@ namespace ft {
     }
 
     tree_iterator& operator--() {
-      _current = get_prev_node(_current, _nil);
+      _current = get_prev_node(_current);
       return (*this);
     }
     tree_iterator operator--(int) {
@@ -178,7 +267,7 @@ namespace ft {
     }
 
     operator tree_iterator<const value_type, node_type>(void) const {
-      return (tree_iterator<const value_type, node_type>(_current, _nil));
+      return (tree_iterator<const value_type, node_type>(_current));
     }
 
     friend bool operator==(const tree_iterator& lhs, const tree_iterator& rhs) {
@@ -192,65 +281,76 @@ namespace ft {
   /* ============================================================ */
   /*                        red-black tree                        */
   /* ============================================================ */
-  template <typename T, class Key, class Comp, class Allocator>
+
+  /*
+  ** header(end)는 value가 없는 TreeNodeBase로 tree 객체 안에 들어 있고, 루트는 header의 왼쪽 자식이다.
+  ** 빈 tree는 node도 pool도 할당하지 않으며, value_type이 기본 생성 가능할 필요가 없다.
+  */
+  template <typename T, class Key, class Comp, class Allocator, class Layout = typename tree_node_layout<T>::type>
   class rbtree {
     public:
     typedef T                                                           value_type;
     typedef Key                                                         key_type;
     typedef Comp                                                        compare_type;
-    typedef TreeNode<value_type>                                        node_type;
-    typedef TreeNode<value_type>*                                       node_pointer;
+    typedef typename Layout::base_type                                  base_type;
+    typedef typename Layout::threaded                                   threaded_type;
+    typedef TreeNode<value_type, base_type>                             node_type;
+    typedef node_type*                                                  node_pointer;
+    typedef base_type*                                                  base_pointer;
     typedef tree_iterator<value_type, node_type>                        iterator;
     typedef tree_iterator<const value_type, node_type>                  const_iterator;
     typedef Allocator                                                   allocator_type;
     typedef typename allocator_type::template rebind<node_type>::other  node_allocator;
-    typedef std::allocator_traits<node_allocator>                       node_traits;
+    typedef ft::node_pool<node_type, node_allocator>                    pool_type;
     typedef std::size_t                                                 size_type;
     typedef std::ptrdiff_t                                              difference_type;
 
     private:
-    node_pointer    _nil;
-    node_pointer    _begin;
-    node_pointer    _end;
+    static const size_type  short_range_erase = 16;
+
+    base_type       _header;
+    base_pointer    _begin;
+    base_pointer    _rightmost;   // 가장 큰 node, 빈 tree에서는 header
     compare_type    _comp;
     node_allocator  _alloc;
+    pool_type*      _pool;
+    bool            _own_pool;  // _pool을 이 tree가 만들었는지 여부
     size_type       _size;
 
     public:
-    rbtree(const compare_type& comp, const allocator_type& alloc)
-      : _comp(comp), _alloc(alloc), _size(size_type()) {
-        _nil = _alloc.allocate(1);
-        _alloc.construct(_nil, value_type());
-        _nil->_is_black = true;
-        _nil->_parent = _nil;
-        _nil->_left = _nil;
-        _nil->_right= _nil;
-        _end = create_node(value_type());
-        _end->_is_black = true;
-        _begin = _end;
+    /*
+    ** node는 pool에서 할당한다.
+    ** pool을 넘기지 않으면 첫 node를 삽입할 때 tree마다 pool을 하나 만들고, 넘기면 그 pool을 공유한다.
+    ** 공유하는 pool은 그 pool을 사용하는 tree가 모두 소멸한 뒤에 소멸해야 한다.
+    */
+    rbtree(const compare_type& comp, const allocator_type& alloc, pool_type* pool = NULL)
+      : _header(), _begin(end_node()), _rightmost(end_node()), _comp(comp), _alloc(alloc), _pool(pool), _own_pool(pool == NULL), _size(size_type()) {
+        _header.set_black(true);
+        thread_reset(threaded_type());
       }
+    /* ref가 공유하는 pool을 사용하고 있다면 복사본도 같은 pool을 공유한다. */
     rbtree(const rbtree& ref)
-      : _comp(ref._comp), _alloc(ref._alloc), _size(size_type()) {
-        _nil = _alloc.allocate(1);
-        _alloc.construct(_nil, value_type());
-        _nil->_is_black = true;
-        _nil->_parent = _nil;
-        _nil->_left = _nil;
-        _nil->_right = _nil;
-        _end = create_node(value_type());
-        _end->_is_black = true;
-        _begin = _end;
-        insert(ref.begin(), ref.end());
+      : _header(), _begin(end_node()), _rightmost(end_node()), _comp(ref._comp), _alloc(ref._alloc),
+        _pool(ref._own_pool ? NULL : ref._pool), _own_pool(ref._own_pool), _size(size_type()) {
+        _header.set_black(true);
+        thread_reset(threaded_type());
+        try {
+          clone(ref);
+        } catch (...) {
+          destroy();
+          throw ;
+        }
       }
     ~rbtree() {
-      delete_node_recursive(_end);
-      delete_node(_nil);
+      destroy();
     }
 
+    /* 대입해도 tree가 사용하는 pool은 바뀌지 않는다. */
     rbtree& operator=(const rbtree& ref) {
       if (this != &ref) {
-        rbtree tmp(ref);
-        swap(tmp);
+        rbtree tmp(ref._comp, _alloc, get_or_create_pool());
+        tmp.clone(ref);
+        swap_nodes(tmp);
       }
       return (*this);
     }
@@ -260,17 +360,17 @@ namespace ft {
     /* ============================================================ */
 
     iterator begin() {
-      return (iterator(_begin, _nil));
+      return (iterator(_begin));
     }
     const_iterator begin() const {
-      return (const_iterator(_begin, _nil));
+      return (const_iterator(_begin));
     }
 
     iterator end() {
-      return (iterator(_end, _nil));
+      return (iterator(end_node()));
     }
     const_iterator end() const {
-      return (const_iterator(_end, _nil));
+      return (const_iterator(end_node()));
     }
 
     /* ============================================================ */
@@ -278,7 +378,7 @@ namespace ft {
     /* ============================================================ */
 
     bool empty() const {
-      return (_size == 0);
+      return (get_root() == NULL);
     }
 
     size_type size() const {
@@ -294,66 +394,230 @@ namespace ft {
     /* ============================================================ */
 
     ft::pair<iterator, bool> insert(const value_type& value) {
-      node_pointer ptr = search_parent(value);
-      if (ptr != _end && is_equal(ptr->_value, value, _comp))
-        return (ft::make_pair(iterator(ptr, _nil), false));
-      return (ft::make_pair(iterator(insert_internal(value, ptr), _nil), true));
+      base_pointer ptr = search_parent(value);
+      if (ptr != end_node() && is_equal(get_value(ptr), value, _comp))
+        return (ft::make_pair(iterator(ptr), false));
+      return (ft::make_pair(iterator(insert_internal(value, ptr)), true));
     }
+    /*
+    ** value를 position 바로 앞에 넣을 수 있으면 트리를 검색하지 않고 position 또는 그 이전 node의 자식으로 연결한다.
+    ** - position == end() : 가장 큰 node(_rightmost)보다 크면 그 오른쪽 자식
+    ** - value < *position : 이전 node보다 크면 이전 node의 오른쪽 또는 position의 왼쪽 자식
+    ** - *position < value : 다음 node보다 작으면 position의 오른쪽 또는 다음 node의 왼쪽 자식
+    ** 중위 순서로 이웃한 두 node 중 하나는 반드시 그 사이의 자식 자리가 비어 있다.
+    ** 조건이 맞지 않으면 hint 없이 삽입한다. 키가 계속 커지는 입력을 end()에 넣으면 삽입마다 비교 한 번이면 된다.
+    */
     iterator insert(iterator position, const value_type& value) {
-      node_pointer ptr = search_parent(value, position.base());
-      if (ptr != _end && is_equal(ptr->_value, value, _comp))
-        return (iterator(ptr, _nil));
-      return (iterator(insert_internal(value, ptr), _nil));
+      base_pointer hint = position.base();
+      if (hint == end_node()) {
+        if (!empty() && _comp(get_value(_rightmost), value))
+          return (iterator(insert_internal(value, _rightmost, false)));
+      } else if (_comp(value, get_value(hint))) {
+        if (hint == _begin)
+          return (iterator(insert_internal(value, hint, true)));
+        base_pointer before = get_prev_node(hint);
+        if (_comp(get_value(before), value)) {
+          if (before->_right == NULL)
+            return (iterator(insert_internal(value, before, false)));
+          return (iterator(insert_internal(value, hint, true)));
+        }
+      } else if (_comp(get_value(hint), value)) {
+        if (hint == _rightmost)
+          return (iterator(insert_internal(value, hint, false)));
+        base_pointer after = get_next_node(hint);
+        if (_comp(value, get_value(after))) {
+          if (hint->_right == NULL)
+            return (iterator(insert_internal(value, hint, false)));
+          return (iterator(insert_internal(value, after, true)));
+        }
+      } else {
+        return (position);
+      }
+      return (insert(value).first);
     }
+    /*
+    ** 빈 tree에 forward iterator 범위를 넣을 때, 범위가 정렬되어 있고 중복이 없으면 build_sorted로 O(n)에 만든다.
+    ** 그 외에는 element를 하나씩 삽입한다.
+    */
     template <class InputIterator>
     void insert(InputIterator first, InputIterator last) {
-      for (; first != last; first++)
-        insert(*first);
+      insert_range(first, last, ft::iterator_category(first));
+    }
+    /* 범위가 정렬되어 있고 중복이 없다고 믿고, 검사 없이 빈 tree를 O(n)에 만든다. */
+    template <class InputIterator>
+    void insert(ft::sorted_unique_t, InputIterator first, InputIterator last) {
+      insert_sorted_unique(first, last, ft::iterator_category(first));
+    }
+    /*
+    ** 정렬되지 않은 범위를 한 번에 넣는다.
+    ** 범위를 정렬하고 중복을 지운 뒤, 직전에 넣은 node(finger)에서 출발해 작은 값부터 차례로 넣는다.
+    ** finger에서 다음 값을 포함하는 가장 낮은 subtree까지만 올라갔다가 내려가므로,
+    ** 크기가 n인 tree에 m개를 넣는 비용이 O(m log n)이 아니라 O(m log(n/m + 1))이다.
+    ** 같은 key가 여러 번 있으면 insert와 같이 먼저 나온 것만 들어간다.
+    ** input iterator는 element를 다시 읽을 수 없으므로 하나씩 삽입한다.
+    */
+    template <class InputIterator>
+    void insert_batch(InputIterator first, InputIterator last) {
+      insert_batch(first, last, ft::iterator_category(first));
     }
 
     iterator erase(iterator position) {
-      if (_size == 0)
-        return (iterator(_nil, _nil));
+      if (empty())
+        return (end());
       iterator tmp(position);
       ++tmp;
+      if (position.base() == _rightmost)
+        _rightmost = (_rightmost == _begin) ? end_node() : get_prev_node(_rightmost);
       if (position == begin())
         _begin = tmp.base();
       --_size;
+      thread_unlink(position.base(), threaded_type());
       remove_internal(position.base());
       delete_node(position.base());
       return (tmp);
     }
     size_type erase(const key_type& value) {
-      iterator i(find_internal(value), _nil);
+      iterator i(find_internal(value));
       if (i == end())
         return (0);
-      if (i == begin()) {
-        iterator tmp(i);
-        ++tmp;
-        _begin = tmp.base();
-      }
-      --_size;
-      remove_internal(i.base());
-      delete_node(i.base());
+      erase(i);
       return (1);
     }
-    void erase(iterator first, iterator last) {
-      for (; first != last;)
-        first = erase(first);
+    /*
+    ** 범위가 짧으면 하나씩 지운다.
+    ** 길면 first와 last 자리에서 tree를 잘라 가운데 subtree들을 떼어내 균형 조정 없이 한꺼번에 해제하고,
+    ** 남은 두 tree를 last node로 다시 잇는다. 균형은 자른 경로를 따라서만 맞추므로 O(log n + k)이다.
+    ** 지운 element의 수를 반환한다.
+    */
+    size_type erase(iterator first, iterator last) {
+      if (first == last)
+        return (0);
+      if (first == begin() && last == end()) {
+        size_type count = size();
+        clear();
+        return (count);
+      }
+      iterator probe(first);
+      size_type count = 0;
+      for (; count < short_range_erase && probe != last; ++count)
+        ++probe;
+      if (probe == last) {
+        for (; first != last;)
+          first = erase(first);
+        return (count);
+      }
+      return (erase_range(first.base(), last.base()));
     }
 
     void swap(rbtree& ref) {
-      std::swap(_nil, ref._nil);
-      std::swap(_begin, ref._begin);
-      std::swap(_end, ref._end);
-      std::swap(_comp, ref._comp);
+      swap_nodes(ref);
       std::swap(_alloc, ref._alloc);
-      std::swap(_size, ref._size);
+      std::swap(_pool, ref._pool);
+      std::swap(_own_pool, ref._own_pool);
     }
 
+    /* node를 모두 pool에 반환한다. 이 tree만 쓰는 pool이면 chunk도 해제한다. */
     void clear(void) {
-      rbtree tmp(_comp, _alloc);
-      swap(tmp);
+      delete_node_recursive(get_root());
+      if (_own_pool && _pool != NULL && _pool->in_use() == 0)
+        _pool->release();
+      _header._left = NULL;
+      _begin = end_node();
+      _rightmost = end_node();
+      _size = 0;
+      thread_reset(threaded_type());
+    }
+
+    /* ============================================================ */
+    /*                         Split, Join                          */
+    /* ============================================================ */
+
+    /*
+    ** key보다 작은 element는 남기고 나머지를 right로 옮긴다. right에 있던 element는 먼저 지운다.
+    ** node를 잘라 잇는 것은 O(log n)이지만, size를 정확히 유지하려고 두 tree 중 작은 쪽의 node를 세므로
+    ** 전체는 O(log n + min(k, n - k))이다. 가운데에서 자르면 n / 2개를 걷는 선형 시간이 된다.
+    ** node에 subtree 크기를 두면 O(log n)으로 만들 수 있지만, node가 포인터 하나만큼 커지고
+    ** 모든 insert, erase, 회전에서 크기를 고쳐야 하므로 split만을 위해 그 비용을 들이지 않았다.
+    ** 세는 동안에는 key를 비교하거나 node를 할당하지 않고 iterator만 따라간다.
+    ** 이 tree가 만든 pool을 쓰면 right의 pool이 이 tree의 pool을 adopt한다.
+    ** 공유하는 pool을 넘겨받은 tree에서 다른 pool을 쓰는 right로 옮길 때만 element를 복사한다.
+    */
+    void split(const key_type& key, rbtree& right) {
+      right.clear();
+      base_pointer pivot = lower_bound_internal(key);
+      if (pivot == end_node())
+        return ;
+      if (pivot == _begin && _own_pool && right._own_pool) {
+        swap(right);
+        return ;
+      }
+      if (right._pool != _pool && !_own_pool) {
+        right.insert(ft::sorted_unique, iterator(pivot), end());
+        erase(iterator(pivot), end());
+        return ;
+      }
+      size_type moved = count_from(pivot);
+      if (right._pool != _pool)
+        right.get_or_create_pool()->adopt(*_pool, moved);
+      base_pointer left;
+      base_pointer rest;
+      size_type lh;
+      size_type rh;
+      size_type height;
+      thread_split(pivot, right, threaded_type());
+      right._rightmost = _rightmost;
+      right._begin = pivot;
+      split_at(pivot, left, lh, rest, rh);
+      right.join_trees(NULL, 0, pivot, rest, rh, height);
+      set_root(left);
+      if (left != NULL) {
+        left->set_black(true);
+        _begin = get_min_node(left);
+        _rightmost = get_max_node(left);
+      } else {
+        _begin = end_node();
+        _rightmost = end_node();
+      }
+      right._size = moved;
+      _size -= moved;
+    }
+
+    /*
+    ** right의 element를 모두 이 tree의 뒤에 붙이고 right를 비운다. right의 모든 key는 이 tree의 모든 key보다 커야 한다.
+    ** right의 가장 작은 node를 떼어 가운데 node로 삼아 O(log n)에 잇는다. right가 만든 pool을 쓰면 이 tree의 pool이 그 pool을 adopt한다.
+    ** right가 공유하는 pool을 넘겨받았고 이 tree와 pool이 다르면 element를 복사해 끝에 넣는다.
+    */
+    void join(rbtree& right) {
+      if (&right == this || right.empty())
+        return ;
+      if (right._pool != _pool) {
+        if (empty() && _own_pool && right._own_pool) {
+          swap(right);
+          return ;
+        }
+        if (!right._own_pool) {
+          for (iterator it = right.begin(); it != right.end(); ++it)
+            insert(end(), *it);
+          right.clear();
+          return ;
+        }
+        get_or_create_pool()->adopt(*right._pool, right._size);
+      }
+      base_pointer pivot = right._begin;
+      base_pointer none;
+      base_pointer rest;
+      size_type nh;
+      size_type rh;
+      size_type height;
+      thread_append(right, threaded_type());
+      if (empty())
+        _begin = pivot;
+      _rightmost = right._rightmost;
+      _size += right._size;
+      right.split_at(pivot, none, nh, rest, rh);
+      join_trees(get_root(), black_height(get_root()), pivot, rest, rh, height);
+      right._header._left = NULL;
+      right.clear();
     }
 
     /* ============================================================ */
@@ -361,31 +625,33 @@ namespace ft {
     /* ============================================================ */
 
     iterator find(const key_type& key) {
-      return (iterator(find_internal(key), _nil));
+      return (iterator(find_internal(key)));
     }
     const_iterator find(const key_type& key) const {
-      return (const_iterator(find_internal(key), _nil));
+      return (const_iterator(find_internal(key)));
     }
 
     iterator lower_bound(const key_type& key) {
-      return (iterator(lower_bound_internal(key), _nil));
+      return (iterator(lower_bound_internal(key)));
     }
     const_iterator lower_bound(const key_type& key) const {
-      return (const_iterator(lower_bound_internal(key), _nil));
+      return (const_iterator(lower_bound_internal(key)));
     }
 
     iterator upper_bound(const key_type& key) {
-      return (iterator(upper_bound_internal(key), _nil));
+      return (iterator(upper_bound_internal(key)));
     }
     const_iterator upper_bound(const key_type& key) const {
-      return (const_iterator(upper_bound_internal(key), _nil));
+      return (const_iterator(upper_bound_internal(key)));
     }
 
     ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
-      return (equal_range_internal(key));
+      ft::pair<base_pointer, base_pointer> range = equal_range_internal(key);
+      return (ft::make_pair(const_iterator(range.first), const_iterator(range.second)));
     }
     ft::pair<iterator, iterator> equal_range(const key_type& key) {
-      return (equal_range_internal(key));
+      ft::pair<base_pointer, base_pointer> range = equal_range_internal(key);
+      return (ft::make_pair(iterator(range.first), iterator(range.second)));
     }
 
     /* ============================================================ */
@@ -396,63 +662,263 @@ namespace ft {
       return (_alloc);
     }
 
+    pool_type* get_pool() const {
+      return (_pool);
+    }
+
     /* ============================================================ */
     /*                   private member function                    */
     /* ============================================================ */
     private:
-    node_pointer get_root() const {
-      return (_end->_left);
+    static const value_type& get_value(const base_pointer ptr) {
+      return (static_cast<node_pointer>(ptr)->_value);
+    }
+
+    base_pointer end_node() const {
+      return (const_cast<base_pointer>(&_header));
+    }
+
+    /*
+    ** node를 모두 반환하고, 이 tree가 만든 pool이면 pool도 놓는다.
+    ** 다른 pool이 그 pool을 adopt했다면 pool은 마지막으로 놓는 쪽이 해제한다.
+    */
+    void destroy() {
+      delete_node_recursive(get_root());
+      if (_own_pool && _pool != NULL) {
+        _pool->release();
+        if (_pool->remove_ref())
+          delete _pool;
+      }
+    }
+
+    /* 이 tree가 pool을 만들어야 하는데 아직 없다면 지금 만든다. */
+    pool_type* get_or_create_pool() {
+      if (_pool == NULL)
+        _pool = new pool_type(pool_type::default_max_chunk_nodes, _alloc);
+      return (_pool);
+    }
+
+    /*
+    ** pivot부터 끝까지의 node 수를 센다.
+    ** 앞에서 pivot까지와 pivot에서 끝까지를 함께 걸어서 먼저 끝나는 쪽으로 계산하므로 짧은 쪽의 길이만큼만 걷는다.
+    */
+    size_type count_from(base_pointer pivot) const {
+      const_iterator front(_begin);
+      const_iterator back(pivot);
+      const_iterator stop(pivot);
+      size_type steps = 0;
+      for (; front != stop && back != end(); ++front, ++back)
+        ++steps;
+      if (front == stop)
+        return (_size - steps);
+      return (steps);
+    }
+
+    /*
+    ** pool과 allocator는 그대로 두고 node와 비교 객체만 교환한다.
+    ** header는 tree 안에 있으므로 루트의 부모와 빈 tree의 _begin을 다시 연결한다.
+    */
+    void swap_nodes(rbtree& ref) {
+      std::swap(_header._left, ref._header._left);
+      std::swap(_begin, ref._begin);
+      std::swap(_rightmost, ref._rightmost);
+      std::swap(_comp, ref._comp);
+      std::swap(_size, ref._size);
+      thread_swap(ref, threaded_type());
+      relink_header();
+      ref.relink_header();
+    }
+
+    void relink_header() {
+      if (_header._left != NULL) {
+        _header._left->set_parent(end_node());
+      } else {
+        _begin = end_node();
+        _rightmost = end_node();
+      }
+      thread_relink(threaded_type());
+    }
+
+    /*
+    ** threaded layout의 이전/다음 node 링크 관리
+    ** 회전은 중위 순서를 바꾸지 않으므로 링크는 node가 들어오고 나갈 때와 header가 바뀔 때만 고친다.
+    ** threaded가 아닌 layout에서는 아무것도 하지 않는다.
+    */
+    void thread_reset(false_type) {}
+    void thread_reset(true_type) {
+      _header._prev = end_node();
+      _header._next = end_node();
+    }
+
+    /* 방금 parent의 자식으로 연결한 ptr을 중위 순서상 자리에 끼워 넣는다. */
+    void thread_link(base_pointer, base_pointer, false_type) {}
+    void thread_link(base_pointer ptr, base_pointer parent, true_type) {
+      base_pointer next;
+      if (parent == end_node() || ptr == parent->_left)
+        next = parent;
+      else
+        next = parent->_next;
+      ptr->_next = next;
+      ptr->_prev = next->_prev;
+      next->_prev->_next = ptr;
+      next->_prev = ptr;
+    }
+
+    void thread_unlink(base_pointer, false_type) {}
+    void thread_unlink(base_pointer ptr, true_type) {
+      ptr->_prev->_next = ptr->_next;
+      ptr->_next->_prev = ptr->_prev;
+    }
+
+    /* [first, last) 범위의 node를 한 번에 뺀다. */
+    void thread_unlink_range(base_pointer, base_pointer, false_type) {}
+    void thread_unlink_range(base_pointer first, base_pointer last, true_type) {
+      first->_prev->_next = last;
+      last->_prev = first->_prev;
+    }
+
+    /* pivot부터 끝까지의 node를 빈 tree인 right의 링크로 옮긴다. */
+    void thread_split(base_pointer, rbtree&, false_type) {}
+    void thread_split(base_pointer pivot, rbtree& right, true_type) {
+      base_pointer last = _header._prev;
+      base_pointer prev = pivot->_prev;
+      prev->_next = end_node();
+      _header._prev = prev;
+      right._header._next = pivot;
+      right._header._prev = last;
+      pivot->_prev = right.end_node();
+      last->_next = right.end_node();
+    }
+
+    /* 비어 있지 않은 right의 링크를 이 tree의 링크 뒤에 붙인다. */
+    void thread_append(rbtree&, false_type) {}
+    void thread_append(rbtree& right, true_type) {
+      base_pointer first = right._header._next;
+      base_pointer last = right._header._prev;
+      _header._prev->_next = first;
+      first->_prev = _header._prev;
+      last->_next = end_node();
+      _header._prev = last;
+    }
+
+    /* 링크 없이 만든 tree의 node를 중위 순서대로 다시 연결한다. */
+    void thread_rebuild(false_type) {}
+    void thread_rebuild(true_type) {
+      thread_reset(true_type());
+      for (base_pointer ptr = _begin; ptr != end_node(); ptr = ft::get_next_node<base_pointer>(ptr))
+        thread_link(ptr, end_node(), true_type());
+    }
+
+    void thread_swap(rbtree&, false_type) {}
+    void thread_swap(rbtree& ref, true_type) {
+      std::swap(_header._prev, ref._header._prev);
+      std::swap(_header._next, ref._header._next);
+    }
+
+    /* 가장 작은 node와 가장 큰 node가 이 tree의 header를 가리키게 한다. */
+    void thread_relink(false_type) {}
+    void thread_relink(true_type) {
+      if (_header._left == NULL) {
+        thread_reset(true_type());
+      } else {
+        _header._next->_prev = end_node();
+        _header._prev->_next = end_node();
+      }
+    }
+
+    base_pointer get_root() const {
+      return (_header._left);
     }
 
-    void set_root(const node_pointer ptr) {
-      ptr->_parent = _end;
-      _end->_left = ptr;
+    void set_root(const base_pointer ptr) {
+      if (ptr != NULL)
+        ptr->set_parent(end_node());
+      _header._left = ptr;
     }
 
-    node_pointer create_node(const value_type& value) {
-      node_pointer ptr = _alloc.allocate(1);
-      _alloc.construct(ptr, value);
-      ptr->_parent = _nil;
-      ptr->_left = _nil;
-      ptr->_right = _nil;
-      ptr->_is_black = false;
+    base_pointer create_node(const value_type& value) {
+      pool_type* pool = get_or_create_pool();
+      node_pointer ptr = pool->allocate();
+      try {
+        _alloc.construct(ptr, value);
+      } catch (...) {
+        pool->deallocate(ptr);
+        throw ;
+      }
+      ptr->set_parent(NULL);
+      ptr->_left = NULL;
+      ptr->_right = NULL;
+      ptr->set_black(false);
       return (ptr);
     }
 
-    void delete_node(node_pointer ptr) {
-      _alloc.destroy(ptr);
-      _alloc.deallocate(ptr, 1);
+    void delete_node(base_pointer ptr) {
+      node_pointer node = static_cast<node_pointer>(ptr);
+      _alloc.destroy(node);
+      _pool->deallocate(node);
     }
 
-    void delete_node_recursive(node_pointer ptr) {
-      if (ptr == _nil)
-        return ;
-      delete_node_recursive(ptr->_left);
-      delete_node_recursive(ptr->_right);
+    /* subtree를 균형 조정 없이 해제하고 해제한 node 수를 반환한다. */
+    size_type delete_node_recursive(base_pointer ptr) {
+      if (ptr == NULL)
+        return (0);
+      size_type count = delete_node_recursive(ptr->_left);
+      count += delete_node_recursive(ptr->_right);
       delete_node(ptr);
+      return (count + 1);
+    }
+
+    /*
+    ** 빈 tree를 ref와 같은 모양으로 만든다.
+    ** 비교 없이 node마다 value, 색, 연결만 복사하고, node는 pool에서 한 번에 확보한다.
+    */
+    void clone(const rbtree& ref) {
+      if (ref.empty())
+        return ;
+      get_or_create_pool()->reserve(ref.size());
+      set_root(clone_subtree(ref.get_root(), end_node()));
+      _begin = get_min_node(get_root());
+      _rightmost = get_max_node(get_root());
+      _size = ref.size();
+      thread_rebuild(threaded_type());
     }
 
-    node_pointer search_parent(const value_type& value, node_pointer position = ft::NIL) {
-      // position hint가 있을 때
-      if (position && position != _end) {
-        if (_comp(value, position->_value) && position->_left == _nil) {
-          iterator prev = iterator(position, _nil);
-          if (prev == begin() || _comp(*--prev, value))
-            return (position);
-        } else if (position->_right == _nil) {
-          iterator next = iterator(position, _nil);
-          if (next == end() || _comp(value, *++next))
-            return (position);
+    /* 오른쪽 subtree는 재귀로, 왼쪽 경로는 반복문으로 복사해서 재귀 깊이를 tree 높이로 제한한다. */
+    base_pointer clone_subtree(base_pointer src, base_pointer parent) {
+      base_pointer top = clone_node(src, parent);
+      try {
+        if (src->_right != NULL)
+          top->_right = clone_subtree(src->_right, top);
+        parent = top;
+        for (src = src->_left; src != NULL; src = src->_left) {
+          base_pointer ptr = clone_node(src, parent);
+          parent->_left = ptr;
+          if (src->_right != NULL)
+            ptr->_right = clone_subtree(src->_right, ptr);
+          parent = ptr;
         }
+      } catch (...) {
+        delete_node_recursive(top);
+        throw ;
       }
-      // position hint가 없을 때
-      node_pointer cur = get_root();
-      node_pointer tmp = _end;
-      for (; cur != _nil;) {
+      return (top);
+    }
+
+    base_pointer clone_node(base_pointer src, base_pointer parent) {
+      base_pointer ptr = create_node(get_value(src));
+      ptr->set_parent(parent);
+      ptr->set_black(src->is_black());
+      return (ptr);
+    }
+
+    base_pointer search_parent(const value_type& value) {
+      base_pointer cur = get_root();
+      base_pointer tmp = end_node();
+      for (; cur != NULL;) {
         tmp = cur;
-        if (_comp(value, cur->_value))
+        if (_comp(value, get_value(cur)))
           cur = cur->_left;
-        else if (_comp(cur->_value, value))
+        else if (_comp(get_value(cur), value))
           cur = cur->_right;
         else
           return (cur);
@@ -460,187 +926,411 @@ namespace ft {
       return (tmp);
     }
 
-    node_pointer insert_internal(const value_type& value, node_pointer parent) {
-      node_pointer ptr = create_node(value);
-      if (parent == _end) {
+    template <class InputIterator>
+    void insert_range(InputIterator first, InputIterator last, input_iterator_tag) {
+      for (; first != last; first++)
+        insert(*first);
+    }
+    template <class ForwardIterator>
+    void insert_range(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+      if (empty() && is_sorted_unique(first, last))
+        build_sorted(first, static_cast<size_type>(ft::distance(first, last)));
+      else
+        insert_range(first, last, input_iterator_tag());
+    }
+
+    template <class InputIterator>
+    void insert_sorted_unique(InputIterator first, InputIterator last, input_iterator_tag) {
+      insert_range(first, last, input_iterator_tag());
+    }
+    template <class ForwardIterator>
+    void insert_sorted_unique(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+      if (empty())
+        build_sorted(first, static_cast<size_type>(ft::distance(first, last)));
+      else
+        insert_range(first, last, input_iterator_tag());
+    }
+
+    /* batch 정렬에 쓰는 node 비교 함수 */
+    struct batch_compare {
+      const compare_type& comp;
+
+      explicit batch_compare(const compare_type& c) : comp(c) {}
+      bool operator()(base_pointer lhs, base_pointer rhs) const {
+        return (comp(get_value(lhs), get_value(rhs)));
+      }
+    };
+    typedef typename allocator_type::template rebind<base_pointer>::other  batch_allocator;
+
+    template <class InputIterator>
+    void insert_batch(InputIterator first, InputIterator last, input_iterator_tag) {
+      insert_range(first, last, input_iterator_tag());
+    }
+    /*
+    ** element를 먼저 모두 node로 만들고 node를 정렬한다.
+    ** 범위의 element 타입이 value_type과 달라도 변환은 한 번만 일어나고, batch의 node가 pool에서 이웃하게 모인다.
+    ** 중복이거나 tree에 이미 있는 key의 node는 연결하지 않고 지운다.
+    */
+    template <class ForwardIterator>
+    void insert_batch(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+      size_type n = static_cast<size_type>(ft::distance(first, last));
+      if (n == 0)
+        return ;
+      batch_allocator alloc(_alloc);
+      base_pointer* buffer = alloc.allocate(n * 2);
+      base_pointer* sorted = buffer;
+      size_type created = 0;
+      size_type linked = 0;
+      try {
+        get_or_create_pool()->reserve(n);
+        for (; created < n; ++created, ++first)
+          buffer[created] = create_node(*first);
+        sort_batch(sorted, buffer + n, n);
+        base_pointer finger = end_node();
+        for (; linked < n; ++linked) {
+          base_pointer ptr = sorted[linked];
+          if (finger != end_node() && !_comp(get_value(finger), get_value(ptr))) {
+            delete_node(ptr);
+            continue ;
+          }
+          finger = insert_after_finger(ptr, finger);
+          if (finger != ptr)
+            delete_node(ptr);
+        }
+      } catch (...) {
+        for (size_type i = (created < n) ? 0 : linked; i < created; ++i)
+          delete_node(sorted[i]);
+        alloc.deallocate(buffer, n * 2);
+        throw ;
+      }
+      alloc.deallocate(buffer, n * 2);
+    }
+
+    /*
+    ** 크기가 n인 두 배열을 번갈아 쓰는 bottom-up merge sort이다.
+    ** 안정 정렬이므로 같은 key 중에서는 범위에서 먼저 나온 것이 앞에 온다.
+    ** src는 단계마다 모든 node가 들어 있는 배열을 가리키고, 끝나면 정렬된 배열을 가리킨다.
+    */
+    void sort_batch(base_pointer*& src, base_pointer* dst, size_type n) const {
+      batch_compare comp(_comp);
+      for (size_type width = 1; width < n; width *= 2) {
+        for (size_type lo = 0; lo < n; lo += width * 2) {
+          size_type mid = (n - lo > width) ? lo + width : n;
+          size_type hi = (n - mid > width) ? mid + width : n;
+          ft::merge(src + lo, src + mid, src + mid, src + hi, dst + lo, comp);
+        }
+        base_pointer* tmp = src;
+        src = dst;
+        dst = tmp;
+      }
+    }
+
+    /*
+    ** finger보다 큰 key의 node를 연결하고 그 node를 반환한다. 같은 key가 이미 있으면 그 node를 반환한다.
+    ** finger가 end이면 root부터 찾는다.
+    ** finger에서 위로 올라가다가, 부모의 왼쪽 자식이고 key가 부모보다 작은 node를 만나면
+    ** 그 subtree 안에 자리가 있으므로 거기서부터 내려간다.
+    */
+    base_pointer insert_after_finger(base_pointer ptr, base_pointer finger) {
+      const value_type& value = get_value(ptr);
+      if (_rightmost == end_node() || _comp(get_value(_rightmost), value))
+        return (link_node(ptr, _rightmost, false));
+      base_pointer cur = get_root();
+      if (finger != end_node()) {
+        for (cur = finger; cur != get_root(); cur = cur->parent()) {
+          if (is_left_child(cur) && _comp(value, get_value(cur->parent())))
+            break ;
+        }
+      }
+      for (;;) {
+        if (_comp(value, get_value(cur))) {
+          if (cur->_left == NULL)
+            return (link_node(ptr, cur, true));
+          cur = cur->_left;
+        } else if (_comp(get_value(cur), value)) {
+          if (cur->_right == NULL)
+            return (link_node(ptr, cur, false));
+          cur = cur->_right;
+        } else {
+          return (cur);
+        }
+      }
+    }
+
+    template <class ForwardIterator>
+    bool is_sorted_unique(ForwardIterator first, ForwardIterator last) const {
+      if (first == last)
+        return (true);
+      ForwardIterator next = first;
+      for (++next; next != last; ++first, ++next) {
+        if (!_comp(*first, *next))
+          return (false);
+      }
+      return (true);
+    }
+
+    /*
+    ** 정렬된 n개의 element로 빈 tree를 만든다.
+    ** 중위 순서대로 재귀하면서 왼쪽 subtree, node, 오른쪽 subtree 순으로 만들기 때문에 입력을 한 번만 읽는다.
+    ** 양쪽 subtree의 크기 차이가 1 이하이므로 모든 빈 자리의 깊이는 h 또는 h + 1이다(h = floor(log2(n + 1))).
+    ** 깊이가 h인 node만 빨간색으로 칠하면 모든 경로의 검은 node 수가 h로 같아진다.
+    */
+    template <class ForwardIterator>
+    void build_sorted(ForwardIterator first, size_type n) {
+      if (n == 0)
+        return ;
+      size_type red_depth = 0;
+      for (size_type full = n + 1; full > 1; full >>= 1)
+        red_depth++;
+      base_pointer root;
+      try {
+        root = build_subtree(first, n, 0, red_depth);
+      } catch (...) {
+        thread_reset(threaded_type());
+        throw ;
+      }
+      set_root(root);
+      _begin = get_min_node(root);
+      _rightmost = get_max_node(root);
+      _size = n;
+    }
+
+    /* 길이가 n인 부분 범위로 subtree를 만들어 루트를 반환한다. first는 사용한 만큼 전진한다. */
+    template <class ForwardIterator>
+    base_pointer build_subtree(ForwardIterator& first, size_type n, size_type depth, size_type red_depth) {
+      if (n == 0)
+        return (NULL);
+      size_type left_n = (n - 1) / 2;
+      base_pointer left = build_subtree(first, left_n, depth + 1, red_depth);
+      base_pointer ptr;
+      try {
+        ptr = create_node(*first);
+      } catch (...) {
+        delete_node_recursive(left);
+        throw ;
+      }
+      ++first;
+      ptr->set_black(depth != red_depth);
+      ptr->_left = left;
+      if (left != NULL)
+        left->set_parent(ptr);
+      thread_link(ptr, end_node(), threaded_type());
+      try {
+        ptr->_right = build_subtree(first, n - 1 - left_n, depth + 1, red_depth);
+      } catch (...) {
+        delete_node_recursive(ptr);
+        throw ;
+      }
+      if (ptr->_right != NULL)
+        ptr->_right->set_parent(ptr);
+      return (ptr);
+    }
+
+    base_pointer insert_internal(const value_type& value, base_pointer parent) {
+      return (insert_internal(value, parent, parent != end_node() && _comp(value, get_value(parent))));
+    }
+    /* parent의 빈 왼쪽(left가 true) 또는 오른쪽 자리에 value를 연결한다. parent가 header면 루트가 된다. */
+    base_pointer insert_internal(const value_type& value, base_pointer parent, bool left) {
+      return (link_node(create_node(value), parent, left));
+    }
+    /* 이미 만든 node를 parent의 자식 자리에 연결하고 균형을 맞춘다. */
+    base_pointer link_node(base_pointer ptr, base_pointer parent, bool left) {
+      if (parent == end_node()) {
         set_root(ptr);
-      } else if (_comp(value, parent->_value)) {
+      } else if (left) {
         parent->_left = ptr;
       } else {
         parent->_right = ptr;
       }
-      ptr->_parent = parent;
+      ptr->set_parent(parent);
+      thread_link(ptr, parent, threaded_type());
+      insert_update(ptr, parent, left);
       insert_fixup(ptr);
-      insert_update(ptr);
       return (ptr);
     }
 
-    void insert_fixup(node_pointer ptr) {
-      while (is_red_color(ptr->_parent)) {
-        if (is_left_child(ptr->_parent)) {
+    void insert_fixup(base_pointer ptr) {
+      while (is_red_color(ptr->parent())) {
+        if (is_left_child(ptr->parent())) {
           insert_fixup_left(ptr);
         } else {
           insert_fixup_right(ptr);
         }
       }
-      get_root()->_is_black = true;
+      get_root()->set_black(true);
     }
 
-    void insert_fixup_left(node_pointer& ptr) {
-      node_pointer uncle = ptr->_parent->_parent->_right;
+    void insert_fixup_left(base_pointer& ptr) {
+      base_pointer uncle = ptr->parent()->parent()->_right;
       if (is_red_color(uncle)) {
-        ptr->_parent->_is_black = true;
-        uncle->_is_black = true;
-        uncle->_parent->_is_black = false;
-        ptr = uncle->_parent;
+        ptr->parent()->set_black(true);
+        uncle->set_black(true);
+        uncle->parent()->set_black(false);
+        ptr = uncle->parent();
       } else {
         if (is_right_child(ptr)) {
-          ptr = ptr->_parent;
+          ptr = ptr->parent();
           rotate_left(ptr);
         }
-        ptr->_parent->_is_black = true;
-        ptr->_parent->_parent->_is_black = false;
-        rotate_right(ptr->_parent->_parent);
+        ptr->parent()->set_black(true);
+        ptr->parent()->parent()->set_black(false);
+        rotate_right(ptr->parent()->parent());
       }
     }
 
-    void insert_fixup_right(node_pointer& ptr) {
-      node_pointer uncle = ptr->_parent->_parent->_left;
+    void insert_fixup_right(base_pointer& ptr) {
+      base_pointer uncle = ptr->parent()->parent()->_left;
       if (is_red_color(uncle)) {
-        ptr->_parent->_is_black = true;
-        uncle->_is_black = true;
-        uncle->_parent->_is_black = false;
-        ptr = uncle->_parent;
+        ptr->parent()->set_black(true);
+        uncle->set_black(true);
+        uncle->parent()->set_black(false);
+        ptr = uncle->parent();
       } else {
         if (is_left_child(ptr)) {
-          ptr = ptr->_parent;
+          ptr = ptr->parent();
           rotate_right(ptr);
         }
-        ptr->_parent->_is_black = true;
-        ptr->_parent->_parent->_is_black = false;
-        rotate_left(ptr->_parent->_parent);
+        ptr->parent()->set_black(true);
+        ptr->parent()->parent()->set_black(false);
+        rotate_left(ptr->parent()->parent());
       }
     }
 
-    void insert_update(const node_pointer ptr) {
-      if (_begin == _end || _comp(ptr->_value, _begin->_value))
+    /* 가장 작은 node의 왼쪽이나 가장 큰 node의 오른쪽에 붙었을 때만 _begin, _rightmost가 바뀐다. */
+    void insert_update(const base_pointer ptr, const base_pointer parent, bool left) {
+      if (parent == end_node()) {
         _begin = ptr;
+        _rightmost = ptr;
+      } else if (left && parent == _begin) {
+        _begin = ptr;
+      } else if (!left && parent == _rightmost) {
+        _rightmost = ptr;
+      }
       _size++;
     }
 
-    void remove_internal(node_pointer ptr) {
-      node_pointer recolor_node;
-      node_pointer fixup_node = ptr;
+    /*
+    ** 빈 자리는 NULL이라 부모를 알 수 없으므로, recolor_node와 함께 그 부모(recolor_parent)를 따로 들고 간다.
+    */
+    void remove_internal(base_pointer ptr) {
+      base_pointer recolor_node;
+      base_pointer recolor_parent;
+      base_pointer fixup_node = ptr;
       bool original_color = is_black_color(ptr);
-      if (ptr->_left == _nil) {
+      if (ptr->_left == NULL) {
         recolor_node = ptr->_right;
+        recolor_parent = ptr->parent();
         transplant(ptr, ptr->_right);
-      } else if (ptr->_right == _nil) {
+      } else if (ptr->_right == NULL) {
         recolor_node = ptr->_left;
+        recolor_parent = ptr->parent();
         transplant(ptr, ptr->_left);
       } else {
-        fixup_node = get_min_node(ptr->_right, _nil);
+        fixup_node = get_min_node(ptr->_right);
         original_color = is_black_color(fixup_node);
         recolor_node = fixup_node->_right;
-        if (fixup_node->_parent == ptr) {
-          recolor_node->_parent = fixup_node;
+        if (fixup_node->parent() == ptr) {
+          recolor_parent = fixup_node;
         } else {
+          recolor_parent = fixup_node->parent();
           transplant(fixup_node, fixup_node->_right);
           fixup_node->_right = ptr->_right;
-          fixup_node->_right->_parent = fixup_node;
+          fixup_node->_right->set_parent(fixup_node);
         }
         transplant(ptr, fixup_node);
         fixup_node->_left = ptr->_left;
-        fixup_node->_left->_parent = fixup_node;
-        fixup_node->_is_black = is_black_color(ptr);
+        fixup_node->_left->set_parent(fixup_node);
+        fixup_node->set_black(is_black_color(ptr));
       }
       if (original_color)
-        remove_fixup(recolor_node);
+        remove_fixup(recolor_node, recolor_parent);
     }
 
-    void remove_fixup(node_pointer ptr) {
+    void remove_fixup(base_pointer ptr, base_pointer parent) {
       while (ptr != get_root() && is_black_color(ptr)) {
-        if (is_left_child(ptr)) {
-          remove_fixup_left(ptr);
+        if (ptr == parent->_left) {
+          remove_fixup_left(ptr, parent);
         } else {
-          remove_fixup_right(ptr);
+          remove_fixup_right(ptr, parent);
         }
       }
-      ptr->_is_black = true;
+      if (ptr != NULL)
+        ptr->set_black(true);
     }
 
-    void remove_fixup_left(node_pointer& ptr) {
-      node_pointer sibling = ptr->_parent->_right;
+    void remove_fixup_left(base_pointer& ptr, base_pointer& parent) {
+      base_pointer sibling = parent->_right;
       if (is_red_color(sibling)) {
-        sibling->_is_black = true;
-        ptr->_parent->_is_black = false;
-        rotate_left(ptr->_parent);
-        sibling = ptr->_parent->_right;
+        sibling->set_black(true);
+        parent->set_black(false);
+        rotate_left(parent);
+        sibling = parent->_right;
       }
       if (is_black_color(sibling->_left) && is_black_color(sibling->_right)) {
-        sibling->_is_black = false;
-        ptr = ptr->_parent;
+        sibling->set_black(false);
+        ptr = parent;
+        parent = ptr->parent();
+        return ;
       } else if (is_black_color(sibling->_right)) {
-        sibling->_left->_is_black = true;
-        sibling->_is_black = false;
+        sibling->_left->set_black(true);
+        sibling->set_black(false);
         rotate_right(sibling);
-        sibling = ptr->_parent->_right;
-      }
-      if (is_red_color(sibling->_right)) {
-        sibling->_is_black = is_black_color(ptr->_parent);
-        ptr->_parent->_is_black = true;
-        sibling->_right->_is_black = true;
-        rotate_left(ptr->_parent);
-        ptr = get_root();
+        sibling = parent->_right;
       }
+      sibling->set_black(is_black_color(parent));
+      parent->set_black(true);
+      sibling->_right->set_black(true);
+      rotate_left(parent);
+      ptr = get_root();
     }
 
-    void remove_fixup_right(node_pointer& ptr) {
-      node_pointer sibling = ptr->_parent->_left;
+    void remove_fixup_right(base_pointer& ptr, base_pointer& parent) {
+      base_pointer sibling = parent->_left;
       if (is_red_color(sibling)) {
-        sibling->_is_black = true;
-        ptr->_parent->_is_black = false;
-        rotate_right(ptr->_parent);
-        sibling = ptr->_parent->_left;
+        sibling->set_black(true);
+        parent->set_black(false);
+        rotate_right(parent);
+        sibling = parent->_left;
       }
       if (is_black_color(sibling->_right) && is_black_color(sibling->_left)) {
-        sibling->_is_black = false;
-        ptr = ptr->_parent;
+        sibling->set_black(false);
+        ptr = parent;
+        parent = ptr->parent();
+        return ;
       } else if (is_black_color(sibling->_left)) {
-        sibling->_right->_is_black = true;
-        sibling->_is_black = false;
+        sibling->_right->set_black(true);
+        sibling->set_black(false);
         rotate_left(sibling);
-        sibling = ptr->_parent->_left;
-      }
-      if (is_red_color(sibling->_left)) {
-        sibling->_is_black = is_black_color(ptr->_parent);
-        ptr->_parent->_is_black = true;
-        sibling->_left->_is_black = true;
-        rotate_right(ptr->_parent);
-        ptr = get_root();
+        sibling = parent->_left;
       }
+      sibling->set_black(is_black_color(parent));
+      parent->set_black(true);
+      sibling->_left->set_black(true);
+      rotate_right(parent);
+      ptr = get_root();
     }
 
-    void transplant(node_pointer former, node_pointer latter) {
-      if (former->_parent == _end) {
+    void transplant(base_pointer former, base_pointer latter) {
+      if (former->parent() == end_node()) {
         set_root(latter);
       } else if (is_left_child(former)) {
-        former->_parent->_left = latter;
+        former->parent()->_left = latter;
       } else {
-        former->_parent->_right = latter;
+        former->parent()->_right = latter;
       }
-      latter->_parent = former->_parent;
+      if (latter != NULL)
+        latter->set_parent(former->parent());
     }
 
-    void rotate_left(node_pointer ptr) {
-      node_pointer child = ptr->_right;
+    void rotate_left(base_pointer ptr) {
+      base_pointer child = ptr->_right;
       ptr->_right = child->_left;
-      if (ptr->_right != _nil) {
-        ptr->_right->_parent = ptr;
+      if (ptr->_right != NULL) {
+        ptr->_right->set_parent(ptr);
       }
-      node_pointer parent = ptr->_parent;
-      child->_parent = parent;
-      if (parent == _end) {
+      base_pointer parent = ptr->parent();
+      child->set_parent(parent);
+      if (parent == end_node()) {
         set_root(child);
       } else if (is_left_child(ptr)) {
         parent->_left = child;
@@ -648,18 +1338,18 @@ namespace ft {
         parent->_right = child;
       }
       child->_left = ptr;
-      ptr->_parent = child;
+      ptr->set_parent(child);
     }
 
-    void rotate_right(node_pointer ptr) {
-      node_pointer child = ptr->_left;
+    void rotate_right(base_pointer ptr) {
+      base_pointer child = ptr->_left;
       ptr->_left = child->_right;
-      if (ptr->_left != _nil) {
-        ptr->_left->_parent = ptr;
+      if (ptr->_left != NULL) {
+        ptr->_left->set_parent(ptr);
       }
-      node_pointer parent = ptr->_parent;
-      child->_parent = parent;
-      if (parent == _end) {
+      base_pointer parent = ptr->parent();
+      child->set_parent(parent);
+      if (parent == end_node()) {
         set_root(child);
       } else if (is_left_child(ptr)) {
         parent->_left = child;
@@ -667,42 +1357,169 @@ namespace ft {
         parent->_right = child;
       }
       child->_right = ptr;
-      ptr->_parent = child;
+      ptr->set_parent(child);
     }
 
-    node_pointer find_internal(const key_type& value) const {
-      node_pointer ptr = get_root();
-      while (ptr != _nil) {
-        if (_comp(value, ptr->_value)) {
-          ptr = ptr->_left;
-        } else if (_comp(ptr->_value, value)) {
-          ptr = ptr->_right;
+    /* ============================================================ */
+    /*                          split, join                         */
+    /* ============================================================ */
+
+    /*
+    ** black height는 subtree의 root에서 빈 자리까지 가는 경로의 검은 node 수이다(빈 자리 자체는 세지 않는다).
+    ** split과 join은 subtree를 root와 black height의 쌍으로 다루고, 작업하는 동안 header의 root 자리를 빌려 쓴다.
+    ** 떼어낸 subtree의 root는 부모 포인터가 남아 있을 수 있으므로 root로 쓰기 전에 set_root로 다시 연결한다.
+    */
+    static size_type black_height(base_pointer ptr) {
+      size_type height = 0;
+      for (; ptr != NULL; ptr = ptr->_left) {
+        if (ptr->is_black())
+          ++height;
+      }
+      return (height);
+    }
+
+    /*
+    ** left의 모든 node < mid < right의 모든 node일 때 셋을 하나의 tree로 잇고 root로 연결한다.
+    ** black height가 낮은 쪽을 높은 쪽의 가장자리 경로에서 black height가 같은 검은 node 자리에 mid와 함께 매달고,
+    ** mid부터 insert와 같은 방법으로 균형을 맞춘다. 비용은 두 black height 차이에 비례한다.
+    */
+    base_pointer join_trees(base_pointer left, size_type lh, base_pointer mid, base_pointer right, size_type rh, size_type& height) {
+      if (is_red_color(left)) {
+        left->set_black(true);
+        ++lh;
+      }
+      if (is_red_color(right)) {
+        right->set_black(true);
+        ++rh;
+      }
+      if (lh == rh) {
+        attach_children(mid, left, right);
+        mid->set_black(true);
+        set_root(mid);
+        height = lh + 1;
+        return (mid);
+      }
+      bool left_taller = (lh > rh);
+      base_pointer root = left_taller ? left : right;
+      size_type target = left_taller ? rh : lh;
+      size_type cur_height = left_taller ? lh : rh;
+      base_pointer parent = NULL;
+      base_pointer cur = root;
+      while (!is_black_color(cur) || cur_height != target) {
+        if (cur->is_black())
+          --cur_height;
+        parent = cur;
+        cur = left_taller ? cur->_right : cur->_left;
+      }
+      if (left_taller) {
+        attach_children(mid, cur, right);
+        parent->_right = mid;
+      } else {
+        attach_children(mid, left, cur);
+        parent->_left = mid;
+      }
+      mid->set_parent(parent);
+      mid->set_black(false);
+      set_root(root);
+      height = left_taller ? lh : rh;
+      while (is_red_color(mid->parent())) {
+        if (is_left_child(mid->parent())) {
+          insert_fixup_left(mid);
         } else {
-          return ptr;
+          insert_fixup_right(mid);
         }
       }
-      return _end;
+      if (!get_root()->is_black()) {
+        get_root()->set_black(true);
+        ++height;
+      }
+      return (get_root());
     }
 
-    node_pointer lower_bound_internal(const key_type& key) const {
-      node_pointer ptr = get_root();
-      node_pointer tmp = _end;
-      while (ptr != _nil) {
-        if (!_comp(ptr->_value, key)) {
-          tmp = ptr;
+    static void attach_children(base_pointer ptr, base_pointer left, base_pointer right) {
+      ptr->_left = left;
+      ptr->_right = right;
+      if (left != NULL)
+        left->set_parent(ptr);
+      if (right != NULL)
+        right->set_parent(ptr);
+    }
+
+    /*
+    ** 현재 root 아래의 node ptr을 기준으로 tree를 ptr보다 앞(left)과 뒤(right)로 나눈다. ptr은 어느 쪽에도 들어가지 않는다.
+    ** ptr에서 root까지 올라가면서, 지나온 쪽의 반대편 subtree를 부모 node와 함께 left나 right에 잇는다.
+    ** 비교 없이 부모 포인터만 따라가고, 이어 붙이는 비용이 합쳐서 O(log n)이다.
+    */
+    void split_at(base_pointer ptr, base_pointer& left, size_type& lh, base_pointer& right, size_type& rh) {
+      size_type height = black_height(ptr->_left);
+      left = ptr->_left;
+      right = ptr->_right;
+      lh = height;
+      rh = height;
+      if (ptr->is_black())
+        ++height;
+      for (base_pointer parent = ptr->parent(); parent != end_node();) {
+        bool from_left = (ptr == parent->_left);
+        base_pointer next = parent->parent();
+        size_type parent_height = height + (parent->is_black() ? 1 : 0);
+        if (from_left)
+          right = join_trees(right, rh, parent, parent->_right, height, rh);
+        else
+          left = join_trees(parent->_left, height, parent, left, lh, lh);
+        ptr = parent;
+        height = parent_height;
+        parent = next;
+      }
+    }
+
+    /* [first, last) 범위의 node를 지우고 지운 수를 반환한다. 범위는 비어 있지 않고 tree 전체가 아니다. */
+    size_type erase_range(base_pointer first, base_pointer last) {
+      base_pointer left;
+      base_pointer middle;
+      base_pointer right = NULL;
+      size_type lh;
+      size_type mh;
+      size_type rh = 0;
+      thread_unlink_range(first, last, threaded_type());
+      split_at(first, left, lh, middle, mh);
+      if (last != end_node()) {
+        set_root(middle);
+        split_at(last, middle, mh, right, rh);
+      }
+      size_type removed = delete_node_recursive(middle);
+      delete_node(first);
+      _size -= removed + 1;
+      if (last != end_node()) {
+        join_trees(left, lh, last, right, rh, mh);
+      } else {
+        set_root(left);
+        if (left != NULL)
+          left->set_black(true);
+      }
+      _begin = empty() ? end_node() : get_min_node(get_root());
+      _rightmost = empty() ? end_node() : get_max_node(get_root());
+      return (removed + 1);
+    }
+
+    base_pointer find_internal(const key_type& value) const {
+      base_pointer ptr = get_root();
+      while (ptr != NULL) {
+        if (_comp(value, get_value(ptr))) {
           ptr = ptr->_left;
-        } else {
+        } else if (_comp(get_value(ptr), value)) {
           ptr = ptr->_right;
+        } else {
+          return ptr;
         }
       }
-      return tmp;
+      return end_node();
     }
 
-    node_pointer upper_bound_internal(const key_type& key) const {
-      node_pointer ptr = get_root();
-      node_pointer tmp = _end;
-      while (ptr != _nil) {
-        if (_comp(key, ptr->_value)) {
+    base_pointer lower_bound_internal(const key_type& key) const {
+      base_pointer ptr = get_root();
+      base_pointer tmp = end_node();
+      while (ptr != NULL) {
+        if (!_comp(get_value(ptr), key)) {
           tmp = ptr;
           ptr = ptr->_left;
         } else {
@@ -712,43 +1529,42 @@ namespace ft {
       return tmp;
     }
 
-    ft::pair<iterator, iterator> equal_range_internal(const key_type& value) {
-      node_pointer ptr = get_root();
-      node_pointer tmp = _end;
-      while (ptr != _nil) {
-        if (_comp(value, ptr->_value)) {
+    base_pointer upper_bound_internal(const key_type& key) const {
+      base_pointer ptr = get_root();
+      base_pointer tmp = end_node();
+      while (ptr != NULL) {
+        if (_comp(key, get_value(ptr))) {
           tmp = ptr;
           ptr = ptr->_left;
-        } else if (_comp(ptr->_value, value)) {
-          ptr = ptr->_right;
         } else {
-          if (ptr->_right != _nil) {
-            tmp = get_min_node(ptr->_right, _nil);
-          }
-          return (ft::make_pair(iterator(ptr, _nil), iterator(tmp, _nil)));
+          ptr = ptr->_right;
         }
       }
-      return (ft::make_pair(iterator(tmp, _nil), iterator(tmp, _nil)));
+      return tmp;
     }
-    ft::pair<const_iterator, const_iterator> equal_range_internal(const key_type& value) const {
-      node_pointer ptr = get_root();
-      node_pointer tmp = _end;
-      while (ptr != _nil) {
-        if (_comp(value, ptr->_value)) {
+
+    ft::pair<base_pointer, base_pointer> equal_range_internal(const key_type& value) const {
+      base_pointer ptr = get_root();
+      base_pointer tmp = end_node();
+      while (ptr != NULL) {
+        if (_comp(value, get_value(ptr))) {
           tmp = ptr;
           ptr = ptr->_left;
-        } else if (_comp(ptr->_value, value)) {
+        } else if (_comp(get_value(ptr), value)) {
           ptr = ptr->_right;
         } else {
-          if (ptr->_right != _nil) {
-            tmp = get_min_node(ptr->_right, _nil);
+          if (ptr->_right != NULL) {
+            tmp = get_min_node(ptr->_right);
           }
-          return (ft::make_pair(const_iterator(ptr, _nil), const_iterator(tmp, _nil)));
+          return (ft::make_pair(ptr, tmp));
         }
       }
-      return (ft::make_pair(const_iterator(tmp, _nil), const_iterator(tmp, _nil)));
+      return (ft::make_pair(tmp, tmp));
     }
   };
+
+  template <typename T, class Key, class Comp, class Allocator, class Layout>
+  const typename rbtree<T, Key, Comp, Allocator, Layout>::size_type rbtree<T, Key, Comp, Allocator, Layout>::short_range_erase;
 }
 
 #endif
@@ -0,0 +1,205 @@
+#ifndef SIMD_HPP_
+# define SIMD_HPP_
+
+/*
+** simd_mismatch, simd_find, simd_count
+** 연속된 메모리를 byte 단위로 비교하는 커널이다. ft::equal, ft::lexicographical_compare, ft::find, ft::count가
+** 정수와 포인터 element의 연속 범위를 만나면 사용한다.
+** 컴파일 옵션에 따라 AVX2(-mavx2)는 32바이트, SSE2(x86-64 기본값)는 16바이트씩 비교하고, 그 외에는 byte 단위로 비교한다.
+**
+** simd_count_less, simd_count_less_equal
+** 정렬된 정수 배열에서 key의 자리를 찾는 커널이다. ft::btree가 node 안에서 key를 찾을 때 사용한다.
+*/
+
+# include <cstddef>   // std::size_t
+# include <cstring>   // std::memcmp
+# if defined(__AVX2__)
+#  include <immintrin.h>
+# elif defined(__SSE2__)
+#  include <emmintrin.h>
+# endif
+
+namespace ft {
+
+  /*
+  ** element 크기가 S일 때, byte 비교 결과 mask에서 element가 시작하는 byte의 bit만 남기는 mask이다.
+  */
+  template <std::size_t S> struct simd_lane_mask;
+  template<> struct simd_lane_mask<1> { static const unsigned int value = 0xFFFFFFFFu; };
+  template<> struct simd_lane_mask<2> { static const unsigned int value = 0x55555555u; };
+  template<> struct simd_lane_mask<4> { static const unsigned int value = 0x11111111u; };
+  template<> struct simd_lane_mask<8> { static const unsigned int value = 0x01010101u; };
+
+  /*
+  ** byte가 같은 위치의 bit가 켜진 mask를 받아, S byte가 모두 같은 element의 시작 bit만 남긴다.
+  */
+  template <std::size_t S>
+  inline unsigned int simd_element_mask(unsigned int byte_mask) {
+    unsigned int mask = byte_mask;
+    for (std::size_t k = 1; k < S; k++)
+      mask &= byte_mask >> k;
+    return (mask & simd_lane_mask<S>::value);
+  }
+
+  /* a와 b의 앞쪽 n byte를 비교해서 처음으로 다른 byte의 위치를 반환한다. 모두 같으면 n을 반환한다. */
+  inline std::size_t simd_mismatch(const unsigned char* a, const unsigned char* b, std::size_t n) {
+    std::size_t i = 0;
+# if defined(__AVX2__)
+    for (; i + 32 <= n; i += 32) {
+      __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+      __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+      unsigned int eq = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)));
+      if (eq != 0xFFFFFFFFu)
+        return (i + __builtin_ctz(~eq));
+    }
+# endif
+# if defined(__SSE2__) || defined(__AVX2__)
+    for (; i + 16 <= n; i += 16) {
+      __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+      __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+      unsigned int eq = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)));
+      if (eq != 0xFFFFu)
+        return (i + __builtin_ctz(~eq));
+    }
+# endif
+    for (; i < n; i++) {
+      if (a[i] != b[i]) return (i);
+    }
+    return (n);
+  }
+
+  /*
+  ** 크기가 S byte인 element n개 중에서 val과 모든 byte가 같은 첫 번째 element의 index를 반환한다. 없으면 n을 반환한다.
+  ** val을 레지스터 폭만큼 반복한 패턴과 byte 단위로 비교하고, element를 이루는 byte가 모두 같은 위치를 찾는다.
+  */
+  template <std::size_t S>
+  std::size_t simd_find(const unsigned char* first, std::size_t n, const unsigned char* val) {
+    std::size_t bytes = n * S;
+    std::size_t i = 0;
+# if defined(__SSE2__) || defined(__AVX2__)
+    unsigned char pattern[32];
+    for (std::size_t k = 0; k < 32; k++)
+      pattern[k] = val[k % S];
+# endif
+# if defined(__AVX2__)
+    __m256i needle = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern));
+    for (; i + 32 <= bytes; i += 32) {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i));
+      unsigned int eq = simd_element_mask<S>(static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle))));
+      if (eq != 0)
+        return ((i + __builtin_ctz(eq)) / S);
+    }
+# elif defined(__SSE2__)
+    __m128i needle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern));
+    for (; i + 16 <= bytes; i += 16) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+      unsigned int eq = simd_element_mask<S>(static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle))));
+      if (eq != 0)
+        return ((i + __builtin_ctz(eq)) / S);
+    }
+# endif
+    for (; i < bytes; i += S) {
+      if (std::memcmp(first + i, val, S) == 0) return (i / S);
+    }
+    return (n);
+  }
+
+  /* 크기가 S byte인 element n개 중에서 val과 모든 byte가 같은 element의 수를 반환한다. */
+  template <std::size_t S>
+  std::size_t simd_count(const unsigned char* first, std::size_t n, const unsigned char* val) {
+    std::size_t bytes = n * S;
+    std::size_t i = 0;
+    std::size_t cnt = 0;
+# if defined(__SSE2__) || defined(__AVX2__)
+    unsigned char pattern[32];
+    for (std::size_t k = 0; k < 32; k++)
+      pattern[k] = val[k % S];
+# endif
+# if defined(__AVX2__)
+    __m256i needle = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern));
+    for (; i + 32 <= bytes; i += 32) {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i));
+      cnt += __builtin_popcount(simd_element_mask<S>(static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle)))));
+    }
+# elif defined(__SSE2__)
+    __m128i needle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern));
+    for (; i + 16 <= bytes; i += 16) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+      cnt += __builtin_popcount(simd_element_mask<S>(static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle)))));
+    }
+# endif
+    for (; i < bytes; i += S) {
+      if (std::memcmp(first + i, val, S) == 0) cnt++;
+    }
+    return (cnt);
+  }
+
+  /*
+  ** 크기가 S byte인 정수와 같은 크기의 부호 있는 정수 타입이다.
+  ** 8 byte 정수는 ft::is_integral에 long long이 없으므로 long이 8 byte인 환경에서만 쓰인다.
+  */
+  template <std::size_t S> struct simd_signed;
+  template<> struct simd_signed<4> { typedef int type; };
+  template<> struct simd_signed<8> { typedef long type; };
+
+  /*
+  ** KeyGreater가 true이면 key > first[i], false이면 first[i] > key인 element의 수를 반환한다.
+  ** 벡터 비교는 부호 있는 비교뿐이므로, 부호 없는 정수는 양쪽의 부호 bit를 뒤집어(bias) 순서를 유지한 채 비교한다.
+  ** 4 byte 정수는 SSE2와 AVX2, 8 byte 정수는 AVX2에서만 벡터로 비교하고 나머지는 하나씩 센다.
+  */
+  template <bool KeyGreater, class T>
+  std::size_t simd_count_greater(const T* first, std::size_t n, T key) {
+    typedef typename simd_signed<sizeof(T)>::type signed_type;
+    std::size_t i = 0;
+    std::size_t cnt = 0;
+    const signed_type* p = reinterpret_cast<const signed_type*>(first);
+    signed_type bias = (T(-1) < T(0)) ? signed_type(0) : static_cast<signed_type>(~(static_cast<T>(-1) >> 1));
+    signed_type k = static_cast<signed_type>(key) ^ bias;
+# if defined(__AVX2__)
+    if (sizeof(T) == 4) {
+      __m256i vk = _mm256_set1_epi32(static_cast<int>(k));
+      __m256i vb = _mm256_set1_epi32(static_cast<int>(bias));
+      for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)), vb);
+        __m256i gt = KeyGreater ? _mm256_cmpgt_epi32(vk, v) : _mm256_cmpgt_epi32(v, vk);
+        cnt += __builtin_popcount(static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(gt))));
+      }
+    } else {
+      __m256i vk = _mm256_set1_epi64x(static_cast<long long>(k));
+      __m256i vb = _mm256_set1_epi64x(static_cast<long long>(bias));
+      for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)), vb);
+        __m256i gt = KeyGreater ? _mm256_cmpgt_epi64(vk, v) : _mm256_cmpgt_epi64(v, vk);
+        cnt += __builtin_popcount(static_cast<unsigned int>(_mm256_movemask_pd(_mm256_castsi256_pd(gt))));
+      }
+    }
+# elif defined(__SSE2__)
+    if (sizeof(T) == 4) {
+      __m128i vk = _mm_set1_epi32(static_cast<int>(k));
+      __m128i vb = _mm_set1_epi32(static_cast<int>(bias));
+      for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)), vb);
+        __m128i gt = KeyGreater ? _mm_cmpgt_epi32(vk, v) : _mm_cmpgt_epi32(v, vk);
+        cnt += __builtin_popcount(static_cast<unsigned int>(_mm_movemask_ps(_mm_castsi128_ps(gt))));
+      }
+    }
+# endif
+    for (; i < n; i++)
+      cnt += KeyGreater ? (key > first[i]) : (first[i] > key);
+    return (cnt);
+  }
+
+  /* 오름차순으로 정렬된 정수 n개 중 key보다 작은 element의 수, 즉 lower_bound의 위치를 반환한다. */
+  template <class T>
+  std::size_t simd_count_less(const T* first, std::size_t n, T key) {
+    return (simd_count_greater<true>(first, n, key));
+  }
+
+  /* 오름차순으로 정렬된 정수 n개 중 key 이하인 element의 수, 즉 upper_bound의 위치를 반환한다. */
+  template <class T>
+  std::size_t simd_count_less_equal(const T* first, std::size_t n, T key) {
+    return (n - simd_count_greater<false>(first, n, key));
+  }
+}
+
+#endif
@@ -4,8 +4,13 @@
 /*
 ** is_integral (integral_constant, true_type, false_type)
 ** enable_if
+** is_same, remove_cv, is_pointer, is_floating_point, is_arithmetic, is_scalar
+** is_trivially_copyable, is_trivially_relocatable
+** alignment_of
 */
 
+# include <cstddef>  // std::size_t
+
 namespace ft {
 
   /* integral_constant */
@@ -48,6 +53,67 @@ namespace ft {
   /* enable_if */
   template <bool Cond, class T = void> struct enable_if {};
   template <class T> struct enable_if<true, T> { typedef T type; };
+
+  /* is_same */
+  template <class T, class U> struct is_same        : public false_type {};
+  template <class T>          struct is_same<T, T>  : public true_type {};
+
+  /* remove_cv */
+  template <class T> struct remove_cv                    { typedef T type; };
+  template <class T> struct remove_cv<const T>           { typedef T type; };
+  template <class T> struct remove_cv<volatile T>        { typedef T type; };
+  template <class T> struct remove_cv<const volatile T>  { typedef T type; };
+
+  /* is_pointer */
+  template <class T> struct is_pointer_helper     : public false_type {};
+  template <class T> struct is_pointer_helper<T*> : public true_type {};
+  template <class T> struct is_pointer : public is_pointer_helper<typename remove_cv<T>::type> {};
+
+  /* is_floating_point */
+  template <class T> struct is_floating_point_helper : public false_type {};
+  template<> struct is_floating_point_helper<float> : public true_type {};
+  template<> struct is_floating_point_helper<double> : public true_type {};
+  template<> struct is_floating_point_helper<long double> : public true_type {};
+  template <class T> struct is_floating_point : public is_floating_point_helper<typename remove_cv<T>::type> {};
+
+  /* is_arithmetic, is_scalar */
+  template <class T>
+  struct is_arithmetic : public integral_constant<bool, is_integral<T>::value || is_floating_point<T>::value> {};
+  template <class T>
+  struct is_scalar : public integral_constant<bool, is_arithmetic<T>::value || is_pointer<T>::value> {};
+
+  /*
+  ** is_trivially_copyable
+  ** 복사 생성, 대입, 소멸이 모두 trivial해서 memcpy로 복사해도 되는 타입인지 식별한다.
+  ** C++98에는 해당 trait이 없으므로 컴파일러 intrinsic을 사용하고, 지원하지 않는 컴파일러에서는 scalar 타입만 true로 본다.
+  */
+# if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5)
+  template <class T>
+  struct is_trivially_copyable : public integral_constant<bool, __is_trivially_copyable(T)> {};
+# else
+  template <class T>
+  struct is_trivially_copyable : public is_scalar<T> {};
+# endif
+
+  /*
+  ** is_trivially_relocatable
+  ** 객체를 memcpy로 다른 주소에 옮긴 뒤 원본의 소멸자를 호출하지 않아도 되는 타입인지 식별한다.
+  ** 기본값은 is_trivially_copyable이고, 자기 자신을 가리키는 포인터가 없는 타입은 직접 특수화해서 true로 만들 수 있다.
+  */
+  template <class T>
+  struct is_trivially_relocatable : public is_trivially_copyable<T> {};
+
+  /*
+  ** alignment_of
+  ** C++98에는 alignof가 없으므로, char 뒤에 T를 둔 구조체에서 T 앞에 생기는 padding으로 정렬 크기를 구한다.
+  */
+  template <class T>
+  struct alignment_of_helper {
+    char  c;
+    T     t;
+  };
+  template <class T>
+  struct alignment_of : public integral_constant<std::size_t, sizeof(alignment_of_helper<T>) - sizeof(T)> {};
 }
 
 #endif
@@ -3,8 +3,11 @@
 
 /*
 ** pair (make_pair)
+** sorted_unique
 */
 
+# include "type_traits.hpp"
+
 namespace ft {
   template <class T1, class T2>
   struct pair {
@@ -33,6 +36,7 @@ namespace ft {
     /* Constructor (1) default */
     pair()                                          : first(first_type()), second(second_type()) {}
     /* Constructor (2) copy */
+    pair(const pair& pr)                            : first(pr.first), second(pr.second) {}
     template<class U, class V>
     pair(const pair<U, V>& pr)                      : first(pr.first), second(pr.second) {}
     /* Constructor (3) initialization */
@@ -85,6 +89,23 @@ namespace ft {
   pair<T1, T2> make_pair(T1 x, T2 y) {
     return (pair<T1, T2>(x, y));
   }
+
+  /*
+  ** sorted_unique
+  ** 범위가 컨테이너의 비교 기준으로 정렬되어 있고 중복된 키가 없다는 것을 알리는 tag이다.
+  ** 정렬 여부를 검사하지 않으므로, 조건을 지키지 않는 범위를 넘기면 컨테이너가 깨진다.
+  */
+  struct sorted_unique_t {};
+  const sorted_unique_t sorted_unique = sorted_unique_t();
+
+  /*
+  ** is_trivially_relocatable
+  ** pair는 대입 연산자를 직접 정의해서 trivially copyable이 아니지만,
+  ** 두 멤버가 모두 relocatable하다면 pair 자체도 memcpy로 옮길 수 있다.
+  */
+  template <class T1, class T2>
+  struct is_trivially_relocatable<pair<T1, T2> >
+    : public integral_constant<bool, is_trivially_relocatable<T1>::value && is_trivially_relocatable<T2>::value> {};
 }
 
 #endif
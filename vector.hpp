@@ -1,9 +1,16 @@
 #ifndef VECTOR_HPP_
 # define VECTOR_HPP_
 
-# include <memory>  // std::allocator
+# include <functional> // std::less
+# include <memory>     // std::allocator
+# include <stdexcept>  // std::length_error, std::out_of_range
+# if __cplusplus >= 201103L
+#  include <iterator>  // std::make_move_iterator
+#  include <utility>   // std::forward, std::move
+# endif
 # include "utils/iterator.hpp"
 # include "utils/algorithm.hpp"
+# include "utils/memory.hpp"
 # include "utils/type_traits.hpp"
 
 namespace ft {
@@ -33,6 +40,7 @@ namespace ft {
     pointer           _ptr;
     size_type         _capacity;  // 할당된 사이즈
     size_type         _size;      // 실제로 담겨 있는 데이터의 수
+    size_type         _trim;      // size가 capacity / _trim 미만으로 줄면 capacity를 줄인다. 0이면 줄이지 않는다.
 
     public:
     /* ============================================================ */
@@ -46,16 +54,23 @@ namespace ft {
     ** element가 없는 빈 컨테이너를 생성한다.
     */
     explicit vector(const allocator_type& alloc = allocator_type())
-      : _alloc(alloc), _ptr(NULL), _capacity(0), _size(0) {}
+      : _alloc(alloc), _ptr(NULL), _capacity(0), _size(0), _trim(0) {}
     /*
     ** Constructor (2) fill
     ** n개의 element를 가지는 컨테이너를 생성하고, 각 element는 val을 복사해 채운다.
     */
     explicit vector(size_type n, const value_type& val = value_type(), const allocator_type& alloc = allocator_type())
-      : _alloc(alloc), _ptr(NULL), _capacity(n), _size(n) {
+      : _alloc(alloc), _ptr(NULL), _capacity(0), _size(0), _trim(0) {
+        if (n == 0) return ;
         _ptr = _alloc.allocate(n);
-        for (size_type i = 0; i < n; i++)
-          _alloc.construct(_ptr + i, val);
+        try {
+          ft::uninitialized_fill_n(_alloc, _ptr, n, val);
+        } catch (...) {
+          _alloc.deallocate(_ptr, n);
+          throw ;
+        }
+        _capacity = ft::allocator_usable_size(_alloc, _ptr, n);
+        _size = n;
       }
     /*
     ** Constructor (3) range
@@ -64,22 +79,30 @@ namespace ft {
     template <class InputIterator>
     vector(InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type(),
       typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL)
-      : _alloc(alloc), _size(0) {
-        difference_type n = last - first;
-        _ptr = _alloc.allocate(n);
-        _capacity = n;
-        for (; first != last; first++)
-          push_back(*first);
+      : _alloc(alloc), _ptr(NULL), _capacity(0), _size(0), _trim(0) {
+        range_init(first, last, ft::iterator_category(first));
       }
     /*
     ** Constructor (4) copy
     ** x에 있는 각 element의 복사본을 동일한 순서대로 복사하여 컨테이너를 생성한다.
-        _capacity = n;
+    ** allocator도 x의 allocator를 복사해서 사용한다.
     */
     vector(const vector& x)
-      : _alloc(allocator_type()), _ptr(NULL), _capacity(0), _size(0) {
+      : _alloc(x._alloc), _ptr(NULL), _capacity(0), _size(0), _trim(x._trim) {
         *this = x;
       }
+# if __cplusplus >= 201103L
+    /*
+    ** Constructor (5) move
+    ** x의 버퍼와 allocator를 그대로 넘겨받고, x는 빈 컨테이너가 된다.
+    */
+    vector(vector&& x) noexcept
+      : _alloc(std::move(x._alloc)), _ptr(x._ptr), _capacity(x._capacity), _size(x._size), _trim(x._trim) {
+        x._ptr = NULL;
+        x._capacity = 0;
+        x._size = 0;
+      }
+# endif
 
     /*
     ** Destructor
@@ -102,6 +125,25 @@ namespace ft {
       }
       return (*this);
     }
+# if __cplusplus >= 201103L
+    /*
+    ** Move assign content
+    ** allocator가 같으면 x의 버퍼를 넘겨받고, 다르면 현재 allocator로 각 element를 이동한다.
+    */
+    vector& operator=(vector&& x) {
+      if (this == &x) return (*this);
+      if (_alloc == x._alloc) {
+        replace_buffer(x._ptr, x._capacity, x._size);
+        x._ptr = NULL;
+        x._capacity = 0;
+        x._size = 0;
+      } else {
+        assign(std::make_move_iterator(x._ptr), std::make_move_iterator(x._ptr + x._size));
+        x.clear();
+      }
+      return (*this);
+    }
+# endif
 
     /* ============================================================ */
     /*                          Iterators                           */
@@ -180,16 +222,13 @@ namespace ft {
     ** n이 현재 capacity보다 큰 경우 메모리를 재할당한다.
     */
     void resize(size_type n, value_type val = value_type()) {
-      if (n > _capacity) reserve(n);
-      if (n >= _size) {
-        for (size_type i = _size; i < n; i++)
-          _alloc.construct(_ptr + i, val);
-      } else {
-        for (size_type i = n; i < _size; i++)
-          _alloc.destroy(_ptr + i);
-        _capacity = n;
+      if (n > _size) {
+        insert(end(), n - _size, val);
+      } else if (n < _size) {
+        ft::destroy(_alloc, _ptr + n, _ptr + _size);
+        _size = n;
+        trim();
       }
-      _size = n;
     }
 
     /*
@@ -200,6 +239,37 @@ namespace ft {
       return (_capacity);
     }
 
+    /*
+    ** Shrink to fit
+    ** capacity를 size에 맞게 줄이고 남는 메모리를 allocator에 돌려준다. 벡터가 비어 있다면 버퍼를 모두 해제한다.
+    ** 재할당하므로 모든 iterator와 참조가 무효화된다. 예외가 발생하면 벡터는 그대로 남는다.
+    */
+    void shrink_to_fit() {
+      if (_capacity == _size) return ;
+      if (_size == 0) {
+        _alloc.deallocate(_ptr, _capacity);
+        _ptr = NULL;
+        _capacity = 0;
+      } else {
+        reallocate_buffer(_size);
+      }
+    }
+
+    /*
+    ** Capacity trimming policy
+    ** divisor가 0이 아니면 pop_back, erase, resize로 size가 capacity / divisor 미만이 되었을 때
+    ** capacity를 size의 두 배로 줄인다. 두 배로 남겨두므로 바로 다시 늘어나도 재할당이 반복되지 않는다.
+    ** 기본값 0은 capacity를 줄이지 않는다. clear는 다시 채워 쓰는 경우가 많으므로 capacity를 유지한다.
+    ** 정책이 켜져 있으면 위 연산들도 재할당할 수 있으므로 반환된 iterator 외의 iterator는 무효화된다.
+    */
+    void set_trim_policy(size_type divisor) {
+      _trim = divisor;
+      trim();
+    }
+    size_type trim_policy() const {
+      return (_trim);
+    }
+
     /* Test whether vector is empty */
     bool empty() const {
       return (size() == 0 ? true : false);
@@ -215,12 +285,7 @@ namespace ft {
       if (n > max_size()) {
         throw (std::length_error("ft::vector::reserve"));
       } else if (n > _capacity) {
-        pointer new_ptr = _alloc.allocate(n);
-        for (size_type i = 0; i < _size; i++)
-          _alloc.construct(new_ptr + i, *(_ptr + i));
-        _alloc.deallocate(_ptr, _capacity);
-        _ptr = new_ptr;
-        _capacity = n;
+        reallocate_buffer(n);
       }
     }
 
@@ -291,27 +356,27 @@ namespace ft {
     template <class InputIterator>
     void assign(InputIterator first, InputIterator last,
       typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL) {
-        clear();
-        size_type n = last - first;
-        if (n == 0) return ;
-        if (n > _capacity) {
-          _alloc.deallocate(_ptr, _capacity);
-          _ptr = _alloc.allocate(n);
-          _capacity = n;
-        }
-        for (; first != last; first++)
-          push_back(*first);
+        range_assign(first, last, ft::iterator_category(first));
       }
     void assign(size_type n, const value_type& val) {
-      clear();
-      if (n == 0) return ;
       if (n > _capacity) {
-        _alloc.deallocate(_ptr, _capacity);
-        _ptr = _alloc.allocate(n);
-        _capacity = n;
+        pointer new_ptr = _alloc.allocate(n);
+        try {
+          ft::uninitialized_fill_n(_alloc, new_ptr, n, val);
+        } catch (...) {
+          _alloc.deallocate(new_ptr, n);
+          throw ;
+        }
+        replace_buffer(new_ptr, n, n);
+      } else if (n > _size) {
+        ft::fill(_ptr, _ptr + _size, val);
+        ft::uninitialized_fill_n(_alloc, _ptr + _size, n - _size, val);
+        _size = n;
+      } else {
+        ft::fill(_ptr, _ptr + n, val);
+        ft::destroy(_alloc, _ptr + n, _ptr + _size);
+        _size = n;
       }
-      for (size_type i = 0; i < n; i++)
-        push_back(val);
     }
 
     /*
@@ -319,12 +384,33 @@ namespace ft {
     ** 벡터의 끝에 val를 추가한다.
     */
     void push_back(const value_type& val) {
-      if (_size == _capacity)
-        empty() ? reserve(1) : reserve(_size * 2);
-      _alloc.construct(_ptr + _size, val);
-      _size++;
+      if (_size == _capacity) {
+        realloc_insert(_size, 1, val);
+      } else {
+        _alloc.construct(_ptr + _size, val);
+        _size++;
+      }
+    }
+# if __cplusplus >= 201103L
+    void push_back(value_type&& val) {
+      emplace_back(std::move(val));
     }
 
+    /*
+    ** Construct and insert element at the end
+    ** args로 벡터의 끝에 element를 직접 생성한다.
+    */
+    template <class... Args>
+    void emplace_back(Args&&... args) {
+      if (_size == _capacity) {
+        realloc_emplace(_size, std::forward<Args>(args)...);
+      } else {
+        std::allocator_traits<allocator_type>::construct(_alloc, _ptr + _size, std::forward<Args>(args)...);
+        _size++;
+      }
+    }
+# endif
+
     /*
     ** Delete last element
     ** 마지막 element를 삭제한다.
@@ -333,6 +419,7 @@ namespace ft {
       if (_size > 0) {
         _alloc.destroy(_ptr + (_size - 1));
         _size--;
+        trim();
       }
     }
 
@@ -342,34 +429,46 @@ namespace ft {
     */
     iterator insert(iterator position, const value_type& val) {
       size_type idx = position - begin();
-      reserve(_size + 1);
-      position = begin() + idx;
-      move_backward(position);
-      _alloc.construct(&(*position), val);
-      _size++;
-      return (position);
+      insert(position, 1, val);
+      return (begin() + idx);
     }
     void insert(iterator position, size_type n, const value_type& val) {
       size_type idx = position - begin();
-      reserve(_size + n);
-      position = begin() + idx;
-      move_backward(position, n);
-      for (size_type i = 0; i < n; i++)
-        _alloc.construct(&(*(position + i)), val);
-      _size += n;
+      if (n == 0) return ;
+      if (n > _capacity - _size) {
+        realloc_insert(idx, n, val);
+      } else if (is_own_element(&val)) {
+        value_type tmp(val);
+        ft::buffer_insert_fill(_alloc, _ptr, _size, idx, n, tmp);
+      } else {
+        ft::buffer_insert_fill(_alloc, _ptr, _size, idx, n, val);
+      }
     }
     template <class InputIterator>
     void insert(iterator position, InputIterator first, InputIterator last,
       typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL) {
-        size_type idx = position - begin();
-        size_type n = last - first;
-        reserve(_size + n);
-        position = begin() + idx;
-        move_backward(position, n);
-        for (size_type i = 0; i < n; i++)
-          _alloc.construct(&(*(position + i)), *(first + i));
-        _size += n;
+        range_insert(position - begin(), first, last, ft::iterator_category(first));
+      }
+# if __cplusplus >= 201103L
+    iterator insert(iterator position, value_type&& val) {
+      return (emplace(position, std::move(val)));
+    }
+
+    /*
+    ** Construct and insert element
+    ** args로 position 위치에 element를 생성하고, 생성한 element를 가리키는 iterator를 반환한다.
+    */
+    template <class... Args>
+    iterator emplace(iterator position, Args&&... args) {
+      size_type idx = position - begin();
+      if (_size == _capacity) {
+        realloc_emplace(idx, std::forward<Args>(args)...);
+      } else {
+        ft::buffer_emplace(_alloc, _ptr, _size, idx, std::forward<Args>(args)...);
       }
+      return (begin() + idx);
+    }
+# endif
 
     /*
     ** Erase elements
@@ -377,30 +476,54 @@ namespace ft {
     */
     iterator erase(iterator position) {
       if (empty()) return (end());
-      iterator it = begin();
-      while (it != position) it++;
-      _alloc.destroy(&(*it));
-      while (it + 1 != end()) {
-        _alloc.construct(&(*it), *(it + 1));
-        it++;
-      }
-      pop_back();
-      return (position);
+      return (erase(position, position + 1));
     }
     iterator erase(iterator first, iterator last) {
-      if (empty()) return (end());
-      iterator it = begin();
-      iterator rtn = first;
-      difference_type dist = last - first;
-      while (it != first) it++;
-      for (; first != last; first++)
-        _alloc.destroy(&(*first));
-      while (it + dist != end()) {
-        _alloc.construct(&(*it), *(it + dist));
-        it++;
+      size_type idx = first - begin();
+      size_type n = last - first;
+      if (n > 0) {
+        ft::buffer_erase(_alloc, _ptr, _size, idx, n);
+        trim();
       }
-      while (dist-- > 0) pop_back();
-      return (rtn);
+      return (begin() + idx);
+    }
+
+    /*
+    ** Erase elements satisfying pred
+    ** pred가 true를 반환하는 element를 모두 제거하고, 제거한 element의 수를 반환한다.
+    ** 남는 element의 순서는 유지되고, 벡터를 한 번만 순회하며 pred는 element마다 한 번씩 호출된다.
+    */
+    template <class Predicate>
+    size_type erase_if(Predicate pred) {
+      size_type removed = ft::buffer_erase_if(_alloc, _ptr, _size, pred);
+      trim();
+      return (removed);
+    }
+
+    /*
+    ** Erase elements at indices
+    ** [first, last)는 size() 미만의 index 범위여야 하고, 중복된 index는 한 번만 제거한다.
+    ** 제거한 element의 수를 반환한다. 남는 element의 순서는 유지되고, 벡터를 한 번만 순회한다.
+    ** index가 오름차순이 아니거나 input iterator로 주어지면 임시 버퍼에 복사해서 정렬한 뒤 제거한다.
+    */
+    template <class InputIterator>
+    size_type erase_indices(InputIterator first, InputIterator last,
+      typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL) {
+        size_type removed = erase_indices_dispatch(first, last, ft::iterator_category(first));
+        trim();
+        return (removed);
+      }
+
+    /*
+    ** Erase element without preserving order
+    ** position의 element를 마지막 element로 덮어쓰고 pop_back 한다. O(1)이지만 element의 순서가 바뀐다.
+    ** position과 같은 위치를 가리키는 iterator를 반환하고, 마지막 element를 지웠다면 end()와 같다.
+    */
+    iterator erase_unordered(iterator position) {
+      size_type idx = position - begin();
+      ft::buffer_erase_unordered(_alloc, _ptr, _size, idx);
+      trim();
+      return (begin() + idx);
     }
 
     /* Swap content */
@@ -409,16 +532,19 @@ namespace ft {
       pointer           tmp_ptr = _ptr;
       size_type         tmp_capacity = _capacity;
       size_type         tmp_size = _size;
+      size_type         tmp_trim = _trim;
 
       _alloc = x._alloc;
       _ptr = x._ptr;
       _capacity = x._capacity;
       _size = x._size;
+      _trim = x._trim;
 
       x._alloc = tmp_alloc;
       x._ptr = tmp_ptr;
       x._capacity = tmp_capacity;
       x._size = tmp_size;
+      x._trim = tmp_trim;
     }
 
     /*
@@ -426,11 +552,8 @@ namespace ft {
     ** 벡터의 모든 element를 제거하고 컨테이너의 크기를 0으로 유지한다.
     */
     void clear() {
-      if (_size > 0) {
-        for (iterator it = begin(); it != end(); it++)
-          _alloc.destroy(&(*it));
-        _size = 0;
-      }
+      ft::destroy(_alloc, _ptr, _ptr + _size);
+      _size = 0;
     }
 
     /* ============================================================ */
@@ -443,11 +566,285 @@ namespace ft {
     }
 
     private:
-    void move_backward(iterator position, size_type n = 1) {
-      if (position == end()) return ;
-        move_backward(position + 1, n);
-      _alloc.construct(&(*(position + n)), *position);
+    /*
+    ** 다음 재할당 때 사용할 capacity를 계산한다.
+    ** capacity를 두 배씩 늘려 push_back의 분할 상환 시간 복잡도를 O(1)로 유지한다.
+    */
+    size_type next_capacity(size_type min_capacity) const {
+      size_type max = max_size();
+      if (min_capacity > max)
+        throw (std::length_error("ft::vector"));
+      if (_capacity >= max / 2)
+        return (max);
+      size_type n = (_capacity == 0) ? 1 : _capacity * 2;
+      return (n < min_capacity ? min_capacity : n);
+    }
+
+    /*
+    ** trim 정책에 따라 capacity를 size의 두 배로 줄인다.
+    ** 메모리를 돌려주는 것은 최적화일 뿐이므로, 재할당 중 예외가 발생하면 벡터를 그대로 두고 무시한다.
+    */
+    void trim() {
+      if (_trim == 0 || _size >= _capacity / _trim) return ;
+      size_type new_capacity = _size * 2;
+      if (new_capacity >= _capacity) return ;
+      try {
+        if (new_capacity == 0) {
+          _alloc.deallocate(_ptr, _capacity);
+          _ptr = NULL;
+          _capacity = 0;
+        } else {
+          reallocate_buffer(new_capacity);
+        }
+      } catch (...) {}
+    }
+
+    /*
+    ** 기존 element를 모두 파괴하고 버퍼를 new_ptr로 바꾼다.
+    ** new_ptr에는 size개의 element가 이미 생성되어 있어야 한다.
+    */
+    void replace_buffer(pointer new_ptr, size_type new_capacity, size_type size) {
+      clear();
+      if (_capacity > 0)
+        _alloc.deallocate(_ptr, _capacity);
+      _ptr = new_ptr;
+      _capacity = ft::allocator_usable_size(_alloc, new_ptr, new_capacity);
+      _size = size;
+    }
+
+    /*
+    ** Range constructor helpers
+    ** input iterator는 길이를 미리 알 수 없으므로 push_back으로 capacity를 두 배씩 늘려가며 읽고,
+    ** forward iterator 이상은 길이를 구해 정확한 크기로 한 번만 할당한 뒤 한꺼번에 복사 생성한다.
+    */
+    template <class InputIterator>
+    void range_init(InputIterator first, InputIterator last, ft::input_iterator_tag) {
+      try {
+        for (; first != last; ++first)
+          push_back(*first);
+      } catch (...) {
+        clear();
+        if (_capacity > 0)
+          _alloc.deallocate(_ptr, _capacity);
+        throw ;
+      }
+    }
+    template <class ForwardIterator>
+    void range_init(ForwardIterator first, ForwardIterator last, ft::forward_iterator_tag) {
+      size_type n = ft::distance(first, last);
+      if (n == 0) return ;
+      if (n > max_size())
+        throw (std::length_error("ft::vector"));
+      _ptr = _alloc.allocate(n);
+      try {
+        ft::uninitialized_copy(_alloc, first, last, _ptr);
+      } catch (...) {
+        _alloc.deallocate(_ptr, n);
+        throw ;
+      }
+      _capacity = ft::allocator_usable_size(_alloc, _ptr, n);
+      _size = n;
+    }
+
+    /*
+    ** Range assign helpers
+    ** forward iterator 이상은 기존 element에는 대입하고 모자란 만큼만 생성하므로, 범위가 자기 자신이어도 안전하다.
+    ** capacity가 부족하면 정확한 크기의 새 버퍼를 먼저 만든 뒤에 기존 버퍼를 해제한다.
+    */
+    template <class InputIterator>
+    void range_assign(InputIterator first, InputIterator last, ft::input_iterator_tag) {
+      clear();
+      for (; first != last; ++first)
+        push_back(*first);
+    }
+    template <class ForwardIterator>
+    void range_assign(ForwardIterator first, ForwardIterator last, ft::forward_iterator_tag) {
+      size_type n = ft::distance(first, last);
+      if (n > _capacity) {
+        if (n > max_size())
+          throw (std::length_error("ft::vector::assign"));
+        pointer new_ptr = _alloc.allocate(n);
+        try {
+          ft::uninitialized_copy(_alloc, first, last, new_ptr);
+        } catch (...) {
+          _alloc.deallocate(new_ptr, n);
+          throw ;
+        }
+        replace_buffer(new_ptr, n, n);
+      } else if (n > _size) {
+        ForwardIterator mid = first;
+        ft::advance(mid, difference_type(_size));
+        ft::copy(first, mid, _ptr);
+        ft::uninitialized_copy(_alloc, mid, last, _ptr + _size);
+        _size = n;
+      } else {
+        pointer new_end = ft::copy(first, last, _ptr);
+        ft::destroy(_alloc, new_end, _ptr + _size);
+        _size = n;
+      }
+    }
+
+    /*
+    ** Range insert helpers
+    ** input iterator는 끝에 삽입할 때는 push_back으로 바로 읽고,
+    ** 중간에 삽입할 때는 임시 벡터에 모은 뒤 forward iterator처럼 한 번에 삽입한다.
+    */
+    template <class InputIterator>
+    void range_insert(size_type idx, InputIterator first, InputIterator last, ft::input_iterator_tag) {
+      if (idx == _size) {
+        for (; first != last; ++first)
+          push_back(*first);
+      } else {
+        vector tmp(first, last, _alloc);
+        range_insert(idx, tmp.begin(), tmp.end(), ft::random_access_iterator_tag());
+      }
+    }
+    template <class ForwardIterator>
+    void range_insert(size_type idx, ForwardIterator first, ForwardIterator last, ft::forward_iterator_tag) {
+      size_type n = ft::distance(first, last);
+      if (n == 0) return ;
+      if (n > _capacity - _size || is_own_range(first, n)) {
+        realloc_insert(idx, first, last, n);
+      } else {
+        ft::buffer_insert_range(_alloc, _ptr, _size, idx, first, last, n);
+      }
+    }
+
+    /* p가 이 벡터에 담긴 element를 가리키는지 확인한다. */
+    bool is_own_element(const void* p) const {
+      return (p >= static_cast<const void*>(_ptr) && p < static_cast<const void*>(_ptr + _size));
+    }
+
+    /* erase_indices helpers, 오름차순인 forward iterator 범위는 복사하지 않고 바로 사용한다. */
+    template <class InputIterator>
+    size_type erase_indices_dispatch(InputIterator first, InputIterator last, ft::input_iterator_tag) {
+      vector<size_type> indices(first, last);
+      return (erase_indices_dispatch(indices.begin(), indices.end(), ft::random_access_iterator_tag()));
+    }
+    template <class ForwardIterator>
+    size_type erase_indices_dispatch(ForwardIterator first, ForwardIterator last, ft::forward_iterator_tag) {
+      if (ft::is_sorted(first, last))
+        return (ft::buffer_erase_indices(_alloc, _ptr, _size, first, last));
+      vector<size_type> indices(first, last);
+      vector<size_type> buffer(indices);
+      ft::stable_sort(indices.begin(), indices.end(), buffer.begin(), std::less<size_type>());
+      return (ft::buffer_erase_indices(_alloc, _ptr, _size, indices.begin(), indices.end()));
+    }
+
+    /*
+    ** first부터 n개의 범위가 이 벡터의 element와 겹치는지 확인한다.
+    ** value_type의 연속된 메모리를 가리키는 iterator만 주소를 비교한다.
+    ** 다른 iterator는 *first가 값이나 proxy를 반환할 수 있어 주소를 얻지 않고, 겹치지 않는다고 본다.
+    */
+    template <class ForwardIterator>
+    bool is_own_range(ForwardIterator first, size_type n) const {
+      typedef typename remove_cv<typename iterator_traits<ForwardIterator>::value_type>::type iter_value_type;
+      return (is_own_range(first, n, integral_constant<bool,
+        is_contiguous_iterator<ForwardIterator>::value && is_same<iter_value_type, value_type>::value>()));
+    }
+    template <class ContiguousIterator>
+    bool is_own_range(ContiguousIterator first, size_type n, true_type) const {
+      const value_type* p = ft::to_address(first);
+      return (is_own_element(p) || is_own_element(p + (n - 1)));
+    }
+    template <class ForwardIterator>
+    bool is_own_range(ForwardIterator, size_type, false_type) const {
+      return (false);
+    }
+
+    /*
+    ** 새 버퍼 new_ptr로 기존 element를 옮기면서 [idx, idx + n) 자리는 비워두고, 기존 버퍼를 해제한다.
+    ** 호출하는 쪽은 그 자리에 새 element를 미리 생성해 두어야 한다.
+    ** 옮기는 중 예외가 발생하면 그 element까지 정리하고 새 버퍼를 해제하며, 기존 버퍼는 그대로 남는다.
+    */
+    void relocate_around(pointer new_ptr, size_type new_capacity, size_type idx, size_type n) {
+      try {
+        ft::relocate_with_gap(_alloc, _ptr, _ptr + idx, _ptr + _size, new_ptr, n);
+      } catch (...) {
+        ft::destroy(_alloc, new_ptr + idx, new_ptr + idx + n);
+        _alloc.deallocate(new_ptr, new_capacity);
+        throw ;
+      }
+      if (_capacity > 0)
+        _alloc.deallocate(_ptr, _capacity);
+      _ptr = new_ptr;
+      _capacity = ft::allocator_usable_size(_alloc, new_ptr, new_capacity);
+      _size += n;
+    }
+
+    /*
+    ** 버퍼의 capacity를 new_capacity로 바꾼다. new_capacity는 size 이상이어야 한다.
+    ** trivially relocatable한 element는 allocator의 reallocate(realloc, mremap)로 제자리에서 늘리거나 줄여서
+    ** 복사를 피하고, allocator가 알려주는 여유 공간까지 capacity로 사용한다.
+    */
+    void reallocate_buffer(size_type new_capacity) {
+      if (ft::is_trivially_relocatable<value_type>::value && _capacity > 0) {
+        _ptr = ft::allocator_reallocate(_alloc, _ptr, _capacity, new_capacity, _size);
+        _capacity = ft::allocator_usable_size(_alloc, _ptr, new_capacity);
+      } else {
+        relocate_around(_alloc.allocate(new_capacity), new_capacity, _size, 0);
+      }
+    }
+
+    /*
+    ** 재할당하면서 idx 위치에 element를 삽입한다.
+    ** 삽입할 값이 이 벡터의 element를 참조할 수도 있으므로 기존 버퍼를 건드리기 전에 새 버퍼에 먼저 생성한다.
+    ** 남은 capacity가 충분한데 호출된 경우(삽입 범위가 자기 자신인 경우)에는 capacity를 유지한다.
+    */
+    void realloc_insert(size_type idx, size_type n, const value_type& val) {
+      size_type new_capacity = (n > _capacity - _size) ? next_capacity(_size + n) : _capacity;
+      if (ft::allocator_has_reallocate<allocator_type>::value && ft::is_trivially_relocatable<value_type>::value
+        && idx == _size && _capacity > 0) {
+          // 끝에 추가할 때는 버퍼를 제자리에서 늘린다. val이 기존 버퍼를 가리킬 수 있으므로 먼저 복사해 둔다.
+          value_type tmp(val);
+          reallocate_buffer(new_capacity);
+          ft::uninitialized_fill_n(_alloc, _ptr + _size, n, tmp);
+          _size += n;
+          return ;
+        }
+      pointer new_ptr = _alloc.allocate(new_capacity);
+      try {
+        ft::uninitialized_fill_n(_alloc, new_ptr + idx, n, val);
+      } catch (...) {
+        _alloc.deallocate(new_ptr, new_capacity);
+        throw ;
+      }
+      relocate_around(new_ptr, new_capacity, idx, n);
+    }
+    template <class ForwardIterator>
+    void realloc_insert(size_type idx, ForwardIterator first, ForwardIterator last, size_type n) {
+      size_type new_capacity = (n > _capacity - _size) ? next_capacity(_size + n) : _capacity;
+      pointer new_ptr = _alloc.allocate(new_capacity);
+      try {
+        ft::uninitialized_copy(_alloc, first, last, new_ptr + idx);
+      } catch (...) {
+        _alloc.deallocate(new_ptr, new_capacity);
+        throw ;
+      }
+      relocate_around(new_ptr, new_capacity, idx, n);
+    }
+# if __cplusplus >= 201103L
+    template <class... Args>
+    void realloc_emplace(size_type idx, Args&&... args) {
+      size_type new_capacity = next_capacity(_size + 1);
+      if (ft::allocator_has_reallocate<allocator_type>::value && ft::is_trivially_relocatable<value_type>::value
+        && idx == _size && _capacity > 0) {
+          value_type tmp(std::forward<Args>(args)...);
+          reallocate_buffer(new_capacity);
+          std::allocator_traits<allocator_type>::construct(_alloc, _ptr + _size, std::move(tmp));
+          _size++;
+          return ;
+        }
+      pointer new_ptr = _alloc.allocate(new_capacity);
+      try {
+        std::allocator_traits<allocator_type>::construct(_alloc, new_ptr + idx, std::forward<Args>(args)...);
+      } catch (...) {
+        _alloc.deallocate(new_ptr, new_capacity);
+        throw ;
+      }
+      relocate_around(new_ptr, new_capacity, idx, 1);
     }
+# endif
   };
 
   /* ============================================================ */